@@ -0,0 +1,551 @@
+#include <vexcore/containers/Archetype.h>
+#include <vexcore/containers/MirroredRing.h>
+#include <vexcore/containers/Ring.h>
+#include <vexcore/containers/SlotMap.h>
+#include <vexcore/containers/SoaVec.h>
+#include <vexcore/containers/SparseSet.h>
+#include <vexcore/utils/Rng.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "bench_config.h"
+
+// containers are checked against std::vector models under random operation sequences
+
+namespace {
+    using namespace vex;
+
+    struct ArchRow {
+        Entity e;
+        std::string name;
+        i32 hp = 0;
+        f64 speed = 0;
+    };
+
+    // model of row removal in Archetype: last row moves into the hole
+    void modelRemoveSwap(std::vector<ArchRow>& rows, i32 row) {
+        rows[row] = rows.back();
+        rows.pop_back();
+    }
+} // namespace
+
+TEST_CASE("archetype model", "[containers]") {
+    // non-trivial component, double destruction or leaks show up under sanitizers
+    using Walker = Archetype<std::string, i32>;
+    using Runner = Archetype<std::string, f64>;
+    Walker walkers;
+    Runner runners;
+    std::vector<ArchRow> model_walkers;
+    std::vector<ArchRow> model_runners;
+
+    auto rng = rng::Rand::make(7);
+    u32 next_index = 0;
+    bool same = true;
+    // several chunks, then back to a few rows
+    for (i32 step = 0; step < 20'000; ++step) {
+        const i32 op = rng.randRange(0, 10);
+        if (op < 6 || model_walkers.empty()) {
+            const Entity e = Entity::make(next_index++ & Entity::k_max_index, 1);
+            const std::string name = "entity with a long name " + std::to_string(step);
+            const i32 row = walkers.add(e, name, step);
+            same &= row == (i32)model_walkers.size();
+            model_walkers.push_back({e, name, step, 0.0});
+        } else if (op < 8) {
+            const i32 row = rng.randRange(0, (i32)model_walkers.size());
+            const Entity relocated = walkers.removeSwap(row);
+            const bool was_last = row == (i32)model_walkers.size() - 1;
+            same &= was_last ? !relocated.isValid() : relocated == model_walkers.back().e;
+            modelRemoveSwap(model_walkers, row);
+        } else {
+            const i32 row = rng.randRange(0, (i32)model_walkers.size());
+            const auto res = walkers.moveTo(row, runners, (f64)step);
+            same &= res.dst_row == (i32)model_runners.size();
+            const bool was_last = row == (i32)model_walkers.size() - 1;
+            same &= was_last ? !res.relocated.isValid()
+                             : res.relocated == model_walkers.back().e;
+            ArchRow moved = model_walkers[row];
+            moved.speed = (f64)step;
+            model_runners.push_back(moved);
+            modelRemoveSwap(model_walkers, row);
+        }
+    }
+    CHECK(same);
+
+    auto matches = [](auto& arch, const std::vector<ArchRow>& model, auto extra) {
+        bool ok = arch.size() == (i32)model.size();
+        for (i32 row = 0; ok && row < arch.size(); ++row) {
+            ok &= arch.entityAt(row) == model[row].e;
+            ok &= arch.template get<std::string>(row) == model[row].name;
+            ok &= extra(arch, row, model[row]);
+        }
+        return ok;
+    };
+    CHECK(matches(walkers, model_walkers, [](Walker& a, i32 row, const ArchRow& m) {
+        return a.get<i32>(row) == m.hp;
+    }));
+    CHECK(matches(runners, model_runners, [](Runner& a, i32 row, const ArchRow& m) {
+        return a.get<f64>(row) == m.speed;
+    }));
+
+    // chunk iteration visits every row once
+    i32 visited = 0;
+    i64 hp_sum = 0;
+    queryChunks<std::string, i32>(
+        [&](i32 count, std::string*, i32* hp) {
+            visited += count;
+            for (i32 i = 0; i < count; ++i)
+                hp_sum += hp[i];
+        },
+        walkers, runners);
+    i64 model_sum = 0;
+    for (const ArchRow& r : model_walkers)
+        model_sum += r.hp;
+    CHECK(visited == (i32)model_walkers.size());
+    CHECK(hp_sum == model_sum);
+
+    // shrink to zero chunks, then reuse, then destruction of emptied archetype
+    CHECK(runners.chunkCount() > 1);
+    runners.clear();
+    runners.shrink();
+    CHECK(runners.size() == 0);
+    CHECK(runners.chunkCount() == 0);
+    runners.add(Entity::make(1, 1), std::string("after shrink"), 1.5);
+    CHECK(runners.get<std::string>(0) == "after shrink");
+    runners.clear();
+    runners.shrink();
+
+    // shrink keeps chunks that hold rows
+    const i32 keep = walkers.size() / 2;
+    while (walkers.size() > keep)
+        walkers.removeSwap(walkers.size() - 1);
+    model_walkers.resize(keep);
+    walkers.shrink();
+    CHECK(matches(walkers, model_walkers, [](Walker& a, i32 row, const ArchRow& m) {
+        return a.get<i32>(row) == m.hp;
+    }));
+}
+
+TEST_CASE("slot map model", "[containers]") {
+    using Handle = SlotHandle32;
+    struct Live {
+        Handle h;
+        std::string val;
+    };
+    SlotMap<std::string> map;
+    std::vector<Live> live;
+    std::vector<Handle> stale;
+
+    auto rng = rng::Rand::make(3);
+    bool same = true;
+    u32 reused = 0;
+    for (i32 step = 0; step < 50'000; ++step) {
+        const i32 op = rng.randRange(0, 10);
+        if (op < 5 || live.empty()) {
+            std::string val = "value number " + std::to_string(step);
+            const Handle h = map.insert(val);
+            same &= h.isValid();
+            for (const Handle& s : stale) {
+                // freed index comes back with a newer generation only
+                if (s.index() == h.index()) {
+                    same &= h.generation() > s.generation();
+                    reused++;
+                }
+            }
+            live.push_back({h, std::move(val)});
+        } else if (op < 8) {
+            const i32 i = rng.randRange(0, (i32)live.size());
+            same &= map.erase(live[i].h);
+            stale.push_back(live[i].h);
+            if (stale.size() > 64)
+                stale.erase(stale.begin());
+            live[i] = std::move(live.back());
+            live.pop_back();
+        } else if (!stale.empty()) {
+            const Handle h = stale[rng.randRange(0, (i32)stale.size())];
+            same &= !map.contains(h);
+            same &= map.find(h) == nullptr;
+            same &= !map.erase(h);
+        }
+    }
+    CHECK(same);
+    CHECK(reused > 0);
+
+    CHECK(map.size() == (i32)live.size());
+    bool found = true;
+    for (const Live& l : live)
+        found &= map.find(l.h) != nullptr && *map.find(l.h) == l.val;
+    CHECK(found);
+    // dense iteration with handles agrees with lookup
+    bool dense = true;
+    for (i32 i = 0; i < map.size(); ++i)
+        dense &= map[map.handleAt(i)] == map.data()[i];
+    CHECK(dense);
+
+    map.clear();
+    CHECK(map.isEmpty());
+    bool gone = true;
+    for (const Live& l : live)
+        gone &= !map.contains(l.h);
+    CHECK(gone);
+
+    // 4 generation bits: slot serves 15 generations, then it is retired for good
+    using SmallGen = SlotHandle<u32, 28>;
+    SlotMap<i32, SmallGen> small;
+    std::vector<SmallGen> handles;
+    for (i32 i = 0; i < 40; ++i) {
+        const SmallGen h = small.insert(i);
+        handles.push_back(h);
+        small.erase(h);
+    }
+    CHECK(handles[0].index() == handles[14].index());
+    CHECK(handles[14].generation() == SmallGen::k_max_gen);
+    CHECK(handles[15].index() != handles[0].index());
+    bool none_alive = true;
+    for (const SmallGen& h : handles)
+        none_alive &= !small.contains(h);
+    CHECK(none_alive);
+}
+
+TEST_CASE("sparse set model", "[containers]") {
+    SparseSet<std::string> set;
+    std::map<u32, std::string> model;
+
+    auto rng = rng::Rand::make(5);
+    // keys over several pages with big empty gaps
+    auto randomKey = [&] { return (u32)rng.randRange(0, 2000) * 37u; };
+    for (i32 step = 0; step < 50'000; ++step) {
+        const u32 key = randomKey();
+        if (rng.randRange(0, 3) != 0) {
+            const std::string val = "value " + std::to_string(step);
+            set.emplace(key, val);
+            model[key] = val;
+        } else {
+            CHECK(set.remove(key) == (model.erase(key) == 1));
+        }
+    }
+
+    // swap-remove keeps keys and values packed and in sync with sparse pages
+    CHECK(set.size() == (i32)model.size());
+    bool same = true;
+    for (i32 i = 0; i < set.size(); ++i) {
+        const u32 key = set.keyAt(i);
+        same &= model.count(key) == 1 && model[key] == set.data()[i];
+        same &= &set[key] == set.data() + i;
+    }
+    for (const auto& [key, val] : model)
+        same &= set.contains(key) && set[key] == val;
+    same &= !set.contains(1) && !set.contains(0xfffff);
+    CHECK(same);
+
+    // replacing with the stored value itself, argument refers into the set
+    const u32 some_key = set.keyAt(0);
+    set[some_key] += " and more text past small string buffer";
+    const std::string expected = set[some_key];
+    set.emplace(some_key, set[some_key]);
+    CHECK(set[some_key] == expected);
+
+    // intersection against model, removing the current key from the driving set
+    SparseSet<i32> a, b, c;
+    std::map<u32, i32> ma, mb, mc;
+    for (i32 i = 0; i < 3000; ++i) {
+        const u32 key = (u32)rng.randRange(0, 5000);
+        a.insert(key, 1);
+        ma[key] = 1;
+        if (i % 2 == 0) {
+            b.insert(key, 2);
+            mb[key] = 2;
+        }
+        if (i % 3 == 0) {
+            c.insert(key * 2, 3);
+            mc[key * 2] = 3;
+        }
+    }
+    std::map<u32, i32> expected_keys;
+    for (const auto& [key, val] : ma)
+        if (mb.count(key) && mc.count(key))
+            expected_keys[key] = val + mb[key] + mc[key];
+    std::map<u32, i32> visited;
+    forEachIntersection(
+        [&](u32 key, i32& va, i32& vb, i32& vc) {
+            visited[key] += va + vb + vc;
+            c.remove(key);
+        },
+        a, b, c);
+    CHECK(!expected_keys.empty());
+    CHECK(visited == expected_keys);
+    CHECK(c.size() == (i32)(mc.size() - expected_keys.size()));
+}
+
+TEST_CASE("soa vec model", "[containers]") {
+    // odd sizes, so unpadded columns would end up misaligned
+    using Row = std::tuple<u8, std::string, f64, u16>;
+    SoaVec<u8, std::string, f64, u16> vec;
+    std::vector<Row> model;
+
+    auto aligned = [&] {
+        auto at64 = [](const void* p) { return (uintptr_t)p % 64 == 0; };
+        return at64(vec.column<0>()) && at64(vec.column<1>()) && at64(vec.column<2>()) &&
+               at64(vec.column<3>());
+    };
+
+    auto rng = rng::Rand::make(9);
+    bool same = true;
+    for (i32 step = 0; step < 30'000; ++step) {
+        const i32 op = rng.randRange(0, 20);
+        if (op < 12 || model.empty()) {
+            Row row{(u8)step, "row with a long enough name " + std::to_string(step),
+                (f64)step * 0.5, (u16)(step * 3)};
+            vec.add(std::get<0>(row), std::get<1>(row), std::get<2>(row), std::get<3>(row));
+            model.push_back(std::move(row));
+            same &= aligned();
+        } else if (op < 19) {
+            const i32 i = rng.randRange(0, (i32)model.size());
+            vec.removeSwapAt(i);
+            model[i] = std::move(model.back());
+            model.pop_back();
+        } else {
+            const i32 num = rng.randRange(0, (i32)model.size() + 100);
+            vec.resize(num);
+            model.resize(num);
+            same &= aligned();
+        }
+    }
+    CHECK(same);
+
+    CHECK(vec.size() == (i32)model.size());
+    bool rows = true;
+    for (i32 i = 0; i < vec.size(); ++i) {
+        rows &= vec.get<0>(i) == std::get<0>(model[i]);
+        rows &= vec.get<1>(i) == std::get<1>(model[i]);
+        rows &= vec.get<2>(i) == std::get<2>(model[i]);
+        rows &= vec.get<3>(i) == std::get<3>(model[i]);
+    }
+    CHECK(rows);
+
+    SoaVec<u8, f64> reserved({}, 1001);
+    CHECK((uintptr_t)reserved.column<0>() % 64 == 0);
+    CHECK((uintptr_t)reserved.column<1>() % 64 == 0);
+}
+
+TEST_CASE("ring model", "[containers]") {
+    Ring<std::string> ring;
+    std::deque<std::string> model;
+
+    // spans have to reproduce front-to-back order, wrapped or not
+    auto spansMatch = [&](const Ring<std::string>& r) {
+        const SplitSpan<const std::string> spans = r.asSpans();
+        bool ok = spans.size() == (i32)model.size();
+        for (i32 i = 0; ok && i < spans.first_len; ++i)
+            ok &= spans.first[i] == model[i];
+        for (i32 i = 0; ok && i < spans.second_len; ++i)
+            ok &= spans.second[i] == model[spans.first_len + i];
+        return ok;
+    };
+
+    auto rng = rng::Rand::make(13);
+    bool same = true;
+    i32 wrapped = 0;
+    i32 grows = 0;
+    for (i32 step = 0; step < 50'000; ++step) {
+        const i32 op = rng.randRange(0, 12);
+        const std::string val = "ring value " + std::to_string(step);
+        const i32 cap = ring.capacity();
+        if (op < 3) {
+            ring.pushBack(val);
+            model.push_back(val);
+        } else if (op < 6) {
+            ring.pushFront(val);
+            model.push_front(val);
+        } else if (op < 8) {
+            auto popped = ring.popFront();
+            same &= popped.hasAnyValue() == !model.empty();
+            if (!model.empty()) {
+                same &= popped.template get<std::string>() == model.front();
+                model.pop_front();
+            }
+        } else if (op < 10) {
+            auto popped = ring.popBack();
+            same &= popped.hasAnyValue() == !model.empty();
+            if (!model.empty()) {
+                same &= popped.template get<std::string>() == model.back();
+                model.pop_back();
+            }
+        } else if (op < 11) {
+            const i32 num = rng.randRange(0, 4);
+            ring.discardFront(num);
+            for (i32 i = 0; i < num && !model.empty(); ++i)
+                model.pop_front();
+        } else {
+            same &= spansMatch(ring);
+        }
+        grows += ring.capacity() != cap ? 1 : 0;
+        wrapped += ring.asSpans().second_len > 0 ? 1 : 0;
+        same &= ring.size() == (i32)model.size();
+        same &= (ring.capacity() & (ring.capacity() - 1)) == 0;
+    }
+    CHECK(same);
+    CHECK(wrapped > 0);
+    CHECK(grows > 1);
+
+    bool items = true;
+    for (i32 i = 0; i < ring.size(); ++i)
+        items &= ring[i] == model[i];
+    CHECK(items);
+    CHECK(spansMatch(ring));
+
+    // growth while wrapped unwraps contents
+    Ring<i32> ints;
+    for (i32 i = 0; i < 8; ++i)
+        ints.pushBack(i);
+    for (i32 i = 0; i < 5; ++i)
+        ints.discardFront(1);
+    for (i32 i = 8; i < 13; ++i)
+        ints.pushBack(i);
+    CHECK(ints.asSpans().second_len > 0);
+    ints.pushBack(13);
+    const SplitSpan<i32> unwrapped = ints.asSpans();
+    CHECK(unwrapped.second_len == 0);
+    bool order = unwrapped.first_len == 9;
+    for (i32 i = 0; order && i < unwrapped.first_len; ++i)
+        order &= unwrapped.first[i] == 5 + i;
+    CHECK(order);
+
+    // copy keeps order
+    const Ring<std::string> copied(ring);
+    CHECK(spansMatch(copied));
+}
+
+TEST_CASE("static ring spans model", "[containers]") {
+    constexpr i32 k_cap = 16;
+    StaticRing<u32, k_cap, true> ring;
+    std::deque<u32> model;
+
+    auto rng = rng::Rand::make(17);
+    u32 next = 0;
+    bool same = true;
+    i32 write_wraps = 0;
+    i32 read_wraps = 0;
+    for (i32 step = 0; step < 50'000; ++step) {
+        const i32 op = rng.randRange(0, 7);
+        if (op < 3) {
+            const i32 want = rng.randRange(0, k_cap + 4);
+            const SplitSpan<u32> span = ring.prepareWrite(want);
+            const i32 free_slots = k_cap - (i32)model.size();
+            same &= span.size() == (want < free_slots ? want : free_slots);
+            write_wraps += span.second_len > 0 ? 1 : 0;
+            for (i32 i = 0; i < span.first_len; ++i)
+                span.first[i] = next + i;
+            for (i32 i = 0; i < span.second_len; ++i)
+                span.second[i] = next + span.first_len + i;
+            // publish only part of what was prepared
+            const i32 num = rng.randRange(0, span.size() + 1);
+            ring.commitWrite(num);
+            for (i32 i = 0; i < num; ++i)
+                model.push_back(next + i);
+            next += num;
+        } else if (op < 6) {
+            const SplitSpan<u32> span = ring.peekRead();
+            same &= span.size() == (i32)model.size();
+            read_wraps += span.second_len > 0 ? 1 : 0;
+            for (i32 i = 0; same && i < span.first_len; ++i)
+                same &= span.first[i] == model[i];
+            for (i32 i = 0; same && i < span.second_len; ++i)
+                same &= span.second[i] == model[span.first_len + i];
+            const i32 num = rng.randRange(0, span.size() + 1);
+            ring.consumeRead(num);
+            model.erase(model.begin(), model.begin() + num);
+        } else {
+            // element API on the same ring, full ring overwrites the oldest
+            ring.push(next);
+            if ((i32)model.size() == k_cap)
+                model.pop_front();
+            model.push_back(next++);
+        }
+        same &= ring.size() == (i32)model.size();
+        // stack interface: at(0) is the newest element
+        for (i32 i = 0; same && i < ring.size(); ++i)
+            same &= ring.at(i) == model[model.size() - 1 - i];
+    }
+    CHECK(same);
+    CHECK(write_wraps > 0);
+    CHECK(read_wraps > 0);
+
+    const auto& const_ring = ring;
+    const SplitSpan<const u32> const_span = const_ring.peekRead();
+    CHECK(const_span.size() == ring.size());
+    CHECK(const_span.first == ring.peekRead().first);
+}
+
+namespace {
+    // reads that start near the end of storage have to continue contiguously past capacity
+    template <typename T>
+    bool checkMirroredRing(i32 min_capacity, u64 seed, i32& reads_past_end) {
+        MirroredRing<T> ring(min_capacity);
+        const i32 cap = ring.capacity();
+        std::deque<T> model;
+        std::vector<T> src(cap);
+        std::vector<T> dst(cap);
+
+        auto rng = rng::Rand::make(seed);
+        u64 next = 0;
+        u64 consumed = 0;
+        bool ok = cap >= min_capacity && (cap & (cap - 1)) == 0;
+        for (i32 step = 0; ok && step < 20'000; ++step) {
+            const i32 num = rng.randRange(0, cap / 3);
+            if (rng.randRange(0, 2) == 0) {
+                for (i32 i = 0; i < num; ++i)
+                    src[i] = (T)(next + i);
+                const i32 free_slots = cap - (i32)model.size();
+                const i32 pushed = ring.pushN(src.data(), num);
+                ok &= pushed == (num < free_slots ? num : free_slots);
+                for (i32 i = 0; i < pushed; ++i)
+                    model.push_back((T)(next + i));
+                next += pushed;
+            } else {
+                const ROSpan<T> all = ring.peek();
+                ok &= all.size() == (i32)model.size();
+                for (i32 i = 0; ok && i < all.size(); ++i)
+                    ok &= all.data[i] == model[i];
+                reads_past_end += (i32)(consumed % cap) + all.size() > cap ? 1 : 0;
+
+                const i32 popped = ring.popN(dst.data(), num);
+                ok &= popped == (num < (i32)model.size() ? num : (i32)model.size());
+                for (i32 i = 0; ok && i < popped; ++i) {
+                    ok &= dst[i] == model.front();
+                    model.pop_front();
+                }
+                consumed += popped;
+            }
+            ok &= ring.size() == (i32)model.size();
+        }
+        return ok;
+    }
+} // namespace
+
+TEST_CASE("mirrored ring model", "[containers]") {
+    i32 reads_past_end = 0;
+    CHECK(checkMirroredRing<u8>(100, 19, reads_past_end));
+    CHECK(checkMirroredRing<u32>(5000, 23, reads_past_end));
+    CHECK(reads_past_end > 0);
+
+    // full ring: one span of exactly capacity elements from any start
+    MirroredRing<u8> ring(64);
+    const i32 cap = ring.capacity();
+    std::vector<u8> bytes(cap);
+    for (i32 i = 0; i < cap; ++i)
+        bytes[i] = (u8)(i * 7);
+    ring.pushN(bytes.data(), cap / 2 + 3);
+    ring.consume(cap / 2 + 3);
+    CHECK(ring.pushN(bytes.data(), cap) == cap);
+    CHECK(ring.isFull());
+    CHECK(!ring.push(1));
+    const ROSpan<u8> full = ring.peek();
+    bool same = full.size() == cap;
+    for (i32 i = 0; same && i < cap; ++i)
+        same &= full.data[i] == bytes[i];
+    CHECK(same);
+}
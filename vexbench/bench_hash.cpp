@@ -0,0 +1,345 @@
+#include <nanobench/nanobench.h>
+#include <vexcore/containers/Dict.h>
+#include <vexcore/utils/HashUtils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_config.h"
+
+namespace {
+    using namespace vex;
+
+    // every candidate produces the i32 that Dict would see
+    struct HashCandidate {
+        const char* name;
+        i32 (*hash)(const u8* data, i32 len);
+    };
+
+    const HashCandidate g_candidates[] = {
+        {"fnv1a", [](const u8* d, i32 n) { return (i32)util::fnv1a((u8*)d, (u32)n); }},
+        {"fnv1a64", [](const u8* d, i32 n) { return (i32)util::fnv1a<true>((u8*)d, (u32)n); }},
+        {"murmur3_x86_32",
+            [](const u8* d, i32 n) { return (i32)murmur::MurmurHash3_x86_32((const char*)d, n); }},
+        {"std::hash",
+            [](const u8* d, i32 n) {
+                return (i32)std::hash<std::string_view>{}(std::string_view((const char*)d, n));
+            }},
+        {"hash64", [](const u8* d, i32 n) { return util::hash32(d, (u64)n); }},
+    };
+
+    // key sets with different shapes, all keys of one set are stored back to back
+    struct KeySet {
+        const char* name = "";
+        std::vector<u8> bytes;
+        std::vector<i32> offsets; // size() + 1 entries
+
+        i32 size() const { return (i32)offsets.size() - 1; }
+        const u8* key(i32 i) const { return bytes.data() + offsets[i]; }
+        i32 keyLen(i32 i) const { return offsets[i + 1] - offsets[i]; }
+        void add(const void* data, i32 len) {
+            if (offsets.empty())
+                offsets.push_back(0);
+            bytes.insert(bytes.end(), (const u8*)data, (const u8*)data + len);
+            offsets.push_back((i32)bytes.size());
+        }
+    };
+
+    KeySet makeSequentialNames(i32 num) {
+        KeySet set;
+        set.name = "\"key_%d\"";
+        char buf[32];
+        for (i32 i = 0; i < num; ++i)
+            set.add(buf, snprintf(buf, sizeof(buf), "key_%d", i));
+        return set;
+    }
+    // ids that differ only in high bits (e.g. handles with generation in upper byte)
+    KeySet makeStridedInts(i32 num) {
+        KeySet set;
+        set.name = "u32 i << 12";
+        for (i32 i = 0; i < num; ++i) {
+            const u32 v = (u32)i << 12;
+            set.add(&v, sizeof(v));
+        }
+        return set;
+    }
+    KeySet makeRandomBytes(i32 num, i32 len) {
+        KeySet set;
+        set.name = "random 16B";
+        auto rng = rng::Rand::make(99);
+        std::vector<u8> buf(len);
+        for (i32 i = 0; i < num; ++i) {
+            for (u8& b : buf)
+                b = (u8)rng.rand();
+            set.add(buf.data(), len);
+        }
+        return set;
+    }
+    // long keys sharing a long prefix, like asset paths
+    constexpr const char* k_path_format = "content/levels/forest/props/rock_%05d.mesh";
+    KeySet makePaths(i32 num) {
+        KeySet set;
+        set.name = "paths ~48B";
+        char buf[96];
+        for (i32 i = 0; i < num; ++i)
+            set.add(buf, snprintf(buf, sizeof(buf), k_path_format, i));
+        return set;
+    }
+
+    /*
+     * SMHasher-style avalanche: flip every input bit of random keys and count how often every
+     * output bit flips. Returns the worst |p - 0.5| over all (input bit, output bit) pairs.
+     */
+    f64 avalancheWorstBias(const HashCandidate& h, i32 key_len, i32 trials) {
+        auto rng = rng::Rand::make(1234);
+        const i32 in_bits = key_len * 8;
+        std::vector<i32> flips(in_bits * 32, 0);
+        std::vector<u8> key(key_len);
+        for (i32 t = 0; t < trials; ++t) {
+            for (u8& b : key)
+                b = (u8)rng.rand();
+            const u32 base = (u32)h.hash(key.data(), key_len);
+            for (i32 bit = 0; bit < in_bits; ++bit) {
+                key[bit / 8] ^= (u8)(1 << (bit % 8));
+                const u32 diff = base ^ (u32)h.hash(key.data(), key_len);
+                key[bit / 8] ^= (u8)(1 << (bit % 8));
+                for (i32 o = 0; o < 32; ++o)
+                    flips[bit * 32 + o] += (diff >> o) & 1;
+            }
+        }
+        f64 worst = 0.0;
+        for (i32 f : flips)
+            worst = std::max(worst, std::abs((f64)f / trials - 0.5));
+        return worst;
+    }
+
+    struct Distribution {
+        f64 score = 0.0; // sum of squared bucket loads vs expected for uniform hash, 1.0 is ideal
+        i32 max_load = 0;
+        i32 collisions = 0; // equal 31-bit values (Dict drops the sign bit)
+        f64 expected_collisions = 0.0;
+    };
+
+    // same bucketing as Dict: prime capacity, (hash & 0x7FFFFFFF) % capacity
+    Distribution measureDistribution(const HashCandidate& h, const KeySet& keys) {
+        const i32 num = keys.size();
+        const i32 cap = util::closestPrimeSearch(num);
+        std::vector<i32> load(cap, 0);
+        std::vector<u32> values(num);
+        for (i32 i = 0; i < num; ++i) {
+            values[i] = (u32)h.hash(keys.key(i), keys.keyLen(i)) & 0x7FFFFFFF;
+            load[values[i] % cap]++;
+        }
+
+        Distribution d;
+        f64 sum_sq = 0.0;
+        for (i32 l : load) {
+            sum_sq += (f64)l * l;
+            d.max_load = std::max(d.max_load, l);
+        }
+        const f64 n = num;
+        d.score = sum_sq / (n + n * (n - 1) / cap);
+
+        std::sort(values.begin(), values.end());
+        for (i32 i = 1; i < num; ++i)
+            d.collisions += values[i] == values[i - 1];
+        d.expected_collisions = n * (n - 1) / 2.0 / 2147483648.0;
+        return d;
+    }
+
+    template <typename THasher>
+    void benchDictFind(bench::Bench& b, const char* name, const std::vector<std::string>& keys) {
+        Dict<std::string, i32, THasher> dict;
+        for (i32 i = 0; i < (i32)keys.size(); ++i)
+            dict.emplace(keys[i], i);
+        b.run(name, [&] {
+            i64 acc = 0;
+            for (const std::string& k : keys)
+                acc += *dict.find(k);
+            useVar(acc);
+        });
+    }
+
+    template <typename TKey, typename TMix>
+    void benchIntPattern(bench::Bench& b, const char* mix_name, const std::vector<TKey>& keys) {
+        using TDict = Dict<TKey, i32, IntKeyHashEq<TKey, TMix>>;
+        TDict dict((u32)keys.size());
+        for (i32 i = 0; i < (i32)keys.size(); ++i)
+            dict.emplace(keys[i], i);
+        const auto stats = dict.chainStats();
+        printf("  %-10s max chain %5d, avg chain %6.2f, used buckets %6d / %u\n", mix_name,
+            stats.max_chain, stats.avg_chain, stats.used_buckets, dict.capacity());
+        // lookups in random order, in insertion order identity would get unfair cache locality
+        std::vector<TKey> lookups = keys;
+        auto rng = rng::Rand::make(5);
+        rng.shuffle(lookups.data(), (i32)lookups.size());
+        b.run(mix_name, [&] {
+            i64 acc = 0;
+            for (TKey k : lookups)
+                acc += *dict.find(k);
+            useVar(acc);
+        });
+    }
+    template <typename TKey>
+    void benchIntPatternAllMixes(const char* pattern, const std::vector<TKey>& keys) {
+        printf("%s\n", pattern);
+        bench::Bench b;
+        b.batch(keys.size()).unit("find").relative(true).title(pattern);
+        benchIntPattern<TKey, util::mix::Identity>(b, "identity", keys);
+        benchIntPattern<TKey, util::mix::Fmix64>(b, "fmix64", keys);
+        benchIntPattern<TKey, util::mix::Splitmix>(b, "splitmix", keys);
+    }
+} // namespace
+
+BENCH("Measure hash throughput", "[hash]") {
+    constexpr i32 k_keys = 1024;
+    for (i32 len : {4, 8, 16, 32, 64, 128, 256, 1024, 4096}) {
+        // distinct keys, so nothing is hoisted out of the loop
+        std::vector<u8> data((size_t)len * k_keys);
+        auto rng = rng::Rand::make(7);
+        for (u8& byte : data)
+            byte = (u8)rng.rand();
+
+        bench::Bench b;
+        b.batch((size_t)len * k_keys).unit("byte").relative(true);
+        b.title(("hash " + std::to_string(len) + "B keys").c_str());
+        for (const HashCandidate& h : g_candidates) {
+            b.run(h.name, [&] {
+                i32 acc = 0;
+                for (i32 k = 0; k < k_keys; ++k)
+                    acc ^= h.hash(data.data() + (size_t)k * len, len);
+                useVar(acc);
+            });
+        }
+    }
+}
+
+TEST_CASE("hash quality", "[hash]") {
+    constexpr i32 k_keys = 200'000;
+    // sigma of a fair bit is 0.5 / sqrt(trials) = 0.0016, worst of 16K pairs stays under 0.01
+    constexpr i32 k_avalanche_trials = 100'000;
+    const KeySet key_sets[] = {makeSequentialNames(k_keys), makeStridedInts(k_keys),
+        makeRandomBytes(k_keys, 16), makePaths(k_keys)};
+
+    printf("\navalanche, worst output bit bias (SMHasher fails above 0.01)\n");
+    printf("%-16s %10s %10s %10s\n", "hash", "4B", "16B", "64B");
+    for (const HashCandidate& h : g_candidates) {
+        const f64 b4 = avalancheWorstBias(h, 4, k_avalanche_trials);
+        const f64 b16 = avalancheWorstBias(h, 16, k_avalanche_trials);
+        const f64 b64 = avalancheWorstBias(h, 64, k_avalanche_trials);
+        printf("%-16s %10.4f %10.4f %10.4f\n", h.name, b4, b16, b64);
+        if (std::string_view(h.name) == "hash64") {
+            CHECK(b4 < 0.01);
+            CHECK(b16 < 0.01);
+            CHECK(b64 < 0.01);
+        }
+    }
+
+    printf("\nDict bucketing (prime modulo), %d keys: score (1.0 = uniform) / max load / "
+           "31-bit collisions (expected)\n",
+        k_keys);
+    for (const KeySet& keys : key_sets) {
+        printf("%s\n", keys.name);
+        for (const HashCandidate& h : g_candidates) {
+            const Distribution d = measureDistribution(h, keys);
+            printf("  %-16s %8.3f %6d %8d (%.1f)\n", h.name, d.score, d.max_load, d.collisions,
+                d.expected_collisions);
+        }
+    }
+}
+
+BENCH("Measure hash dict find", "[hash]") {
+    constexpr i32 k_keys = 100'000;
+    std::vector<std::string> short_keys;
+    std::vector<std::string> long_keys;
+    char buf[96];
+    for (i32 i = 0; i < k_keys; ++i) {
+        short_keys.emplace_back(buf, snprintf(buf, sizeof(buf), "ent_%d", i));
+        long_keys.emplace_back(buf,
+            snprintf(buf, sizeof(buf), k_path_format, i));
+    }
+
+    for (const auto* keys : {&short_keys, &long_keys}) {
+        bench::Bench b;
+        b.batch(k_keys).unit("find").relative(true);
+        b.title(keys == &short_keys ? "Dict<std::string> find, ~9B keys"
+                                    : "Dict<std::string> find, ~48B keys");
+        benchDictFind<KeyHashEq<std::string>>(b, "KeyHashEq (hash64)", *keys);
+        benchDictFind<util::SHash_STD>(b, "SHash_STD", *keys);
+        benchDictFind<util::SHash_FNV1a>(b, "SHash_FNV1a", *keys);
+        benchDictFind<util::SHash_MURMUR>(b, "SHash_MURMUR", *keys);
+    }
+}
+
+/*
+ * Adversarial integer keys for Dict: chain statistics per mixing policy are printed before
+ * find throughput. Identity on strided keys is the "std::hash of int" behavior.
+ */
+BENCH("Measure int key mixing", "[hash]") {
+    constexpr i32 k_keys = 30'000;
+    // bucket count Dict picks for this size, keys that are multiples of it share one bucket
+    const i32 cap = util::closestPrimeSearch(k_keys);
+
+    std::vector<i32> sequential, cap_multiples, low_bits_clear;
+    std::vector<u64> pointer_like, high_word_ids;
+    for (i32 i = 0; i < k_keys; ++i) {
+        sequential.push_back(i);
+        cap_multiples.push_back(i * cap);
+        low_bits_clear.push_back(i << 16);
+        pointer_like.push_back(0x7F3A00000000ull + (u64)i * 256);
+        high_word_ids.push_back((u64)i << 32);
+    }
+
+    benchIntPatternAllMixes("i32 sequential", sequential);
+    benchIntPatternAllMixes("i32 multiples of capacity", cap_multiples);
+    benchIntPatternAllMixes("i32 i << 16", low_bits_clear);
+    benchIntPatternAllMixes("u64 pointer-like, 256B stride", pointer_like);
+    benchIntPatternAllMixes("u64 i << 32", high_word_ids);
+}
+
+TEST_CASE("crc32c", "[hash]") {
+    CHECK(util::crc32c((const u8*)"123456789", 9) == 0xE3069283u);
+    CHECK(util::crc32cSlice8((const u8*)"123456789", 9) == 0xE3069283u);
+
+    std::vector<u8> data(100'000);
+    auto rng = rng::Rand::make(11);
+    for (u8& byte : data)
+        byte = (u8)rng.rand();
+
+    // unaligned starts and lengths around the interleaved block sizes
+    for (u64 len : {0ull, 1ull, 7ull, 767ull, 768ull, 769ull, 24576ull, 24577ull, 99'990ull}) {
+        for (u64 off = 0; off < 8; ++off)
+            CHECK(util::crc32c(data.data() + off, len) ==
+                  util::crc32cSlice8(data.data() + off, len));
+    }
+
+    // chunked as during file i/o
+    const u32 whole = util::crc32c(data.data(), data.size());
+    u32 crc = 0;
+    u64 pos = 0;
+    for (u64 chunk = 1; pos < data.size(); chunk = chunk * 3 + 1) {
+        const u64 len = std::min<u64>(chunk, data.size() - pos);
+        crc = util::crc32c(data.data() + pos, len, crc);
+        pos += len;
+    }
+    CHECK(crc == whole);
+}
+
+BENCH("Measure crc32c", "[hash]") {
+    for (i32 len : {64, 4096, 1 << 20}) {
+        std::vector<u8> data((size_t)len);
+        auto rng = rng::Rand::make(13);
+        for (u8& byte : data)
+            byte = (u8)rng.rand();
+
+        bench::Bench b;
+        b.batch((size_t)len).unit("byte").relative(true);
+        b.title(("crc32c " + std::to_string(len) + "B").c_str());
+        b.run("slice-by-8", [&] { useVar(util::crc32cSlice8(data.data(), data.size())); });
+        b.run("crc32c", [&] { useVar(util::crc32c(data.data(), data.size())); });
+        b.run("hash64", [&] { useVar(util::hash64(data.data(), data.size())); });
+    }
+}
@@ -0,0 +1,318 @@
+#include <nanobench/nanobench.h>
+#include <vexcore/containers/WorkStealingDeque.h>
+#include <vexcore/jobs/Task.h>
+#include <vexcore/jobs/TaskGraph.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_config.h"
+
+namespace {
+    // owner pushes 'items' values in bursts and pops some of them itself, thieves steal the rest
+    // returns number of values taken by thieves, 'seen' counts how many times each was taken
+    i32 runStealing(i32 thieves, i32 items, std::atomic<u8>* seen) {
+        using namespace vex;
+        WorkStealingDeque<u32> deque({}, 16); // small to exercise growth
+        std::atomic<i32> taken{0};
+        std::atomic<i32> stolen{0};
+        std::atomic<bool> done{false};
+
+        auto take = [&](u32 val) {
+            if (seen)
+                seen[val].fetch_add(1, std::memory_order_relaxed);
+            taken.fetch_add(1, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> workers;
+        for (i32 i = 0; i < thieves; ++i) {
+            workers.emplace_back([&] {
+                u32 val = 0;
+                i32 local = 0;
+                while (!done.load(std::memory_order_acquire)) {
+                    const EStealResult res = deque.steal(val);
+                    if (res == EStealResult::Success) {
+                        take(val);
+                        local++;
+                    } else if (res == EStealResult::Empty) {
+                        std::this_thread::yield();
+                    }
+                }
+                stolen.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+
+        constexpr i32 k_burst = 256;
+        for (i32 pushed = 0; pushed < items;) {
+            const i32 num = items - pushed < k_burst ? items - pushed : k_burst;
+            for (i32 i = 0; i < num; ++i)
+                deque.push((u32)(pushed + i));
+            pushed += num;
+            // owner keeps a quarter of the burst for itself
+            for (i32 i = 0; i < num / 4; ++i) {
+                auto val = deque.pop();
+                if (!val.hasAnyValue())
+                    break;
+                take(val.template get<u32>());
+            }
+        }
+        // drain, competing with thieves for the last elements
+        while (taken.load(std::memory_order_relaxed) < items) {
+            auto val = deque.pop();
+            if (val.hasAnyValue())
+                take(val.template get<u32>());
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& w : workers)
+            w.join();
+        return stolen.load();
+    }
+} // namespace
+
+TEST_CASE("work stealing deque stress", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_items = 200'000;
+    auto seen = std::make_unique<std::atomic<u8>[]>(k_items);
+    for (i32 thieves : {1, 3, 7}) {
+        for (i32 i = 0; i < k_items; ++i)
+            seen[i].store(0, std::memory_order_relaxed);
+        runStealing(thieves, k_items, seen.get());
+        i32 bad = 0;
+        for (i32 i = 0; i < k_items; ++i)
+            bad += seen[i].load(std::memory_order_relaxed) != 1 ? 1 : 0;
+        CHECK(bad == 0);
+    }
+}
+
+// more grains than one job pool page holds, every split job stays live until its children end
+TEST_CASE("parallelFor many grains", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_grains = 1 << 16;
+    auto hits = std::make_unique<std::atomic<u8>[]>(k_grains);
+    for (i32 i = 0; i < k_grains; ++i)
+        hits[i].store(0, std::memory_order_relaxed);
+
+    JobSystem jobs(2);
+    jobs.parallelFor(Range(0, k_grains), 1, [&](Range r) {
+        for (i32 i = r.range_start; i < r.range_end; ++i)
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    i32 bad = 0;
+    for (i32 i = 0; i < k_grains; ++i)
+        bad += hits[i].load(std::memory_order_relaxed) != 1 ? 1 : 0;
+    CHECK(bad == 0);
+}
+
+// wider than one job pool page, all tasks are children of the graph's frame job
+TEST_CASE("task graph many tasks", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_tasks = 20'000;
+    constexpr i32 k_stride = 1000;
+    auto runs = std::make_unique<std::atomic<i32>[]>(k_tasks);
+    std::atomic<i32> early{0};
+
+    JobSystem jobs(2);
+    for (bool with_edges : {false, true}) {
+        for (i32 i = 0; i < k_tasks; ++i)
+            runs[i].store(0, std::memory_order_relaxed);
+
+        TaskGraph graph;
+        for (i32 i = 0; i < k_tasks; ++i) {
+            graph.add([&runs, &early, i, with_edges] {
+                if (with_edges && i >= k_stride &&
+                    runs[i - k_stride].load(std::memory_order_acquire) == 0)
+                    early.fetch_add(1, std::memory_order_relaxed);
+                runs[i].fetch_add(1, std::memory_order_release);
+            });
+        }
+        if (with_edges) {
+            for (i32 i = k_stride; i < k_tasks; ++i)
+                graph.precede(i - k_stride, i);
+        }
+        graph.compile();
+        graph.run(jobs);
+
+        i32 bad = 0;
+        for (i32 i = 0; i < k_tasks; ++i)
+            bad += runs[i].load(std::memory_order_relaxed) != 1 ? 1 : 0;
+        CHECK(bad == 0);
+    }
+    CHECK(early.load() == 0);
+}
+
+BENCH("Measure work stealing", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_items = 1 << 20;
+
+    bench::Bench b;
+    b.batch(k_items).unit("item").epochs(3);
+    for (i32 thieves : {1, 2, 4, 8, 16}) {
+        b.run("steal: " + std::to_string(thieves) + " thieves", [&] {
+            useVar(runStealing(thieves, k_items, nullptr));
+        });
+    }
+}
+
+BENCH("Measure task graph", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_tasks = 1024;
+    constexpr i32 k_layer = 32;
+
+    JobSystem jobs;
+    ExpandableBufferAllocator arena(64 * 1024);
+    std::atomic<u32> sink{0};
+    auto task = [&sink] { sink.fetch_add(1, std::memory_order_relaxed); };
+
+    TaskGraph wide(arena.makeAllocatorHandle());
+    for (i32 i = 0; i < k_tasks; ++i)
+        wide.add(task);
+    wide.compile();
+
+    TaskGraph chain(arena.makeAllocatorHandle());
+    for (i32 i = 0; i < k_tasks; ++i) {
+        const TaskGraph::TaskId id = chain.add(task);
+        if (i > 0)
+            chain.precede(id - 1, id);
+    }
+    chain.compile();
+
+    // every task depends on two tasks of the previous layer
+    TaskGraph layered(arena.makeAllocatorHandle());
+    for (i32 i = 0; i < k_tasks; ++i) {
+        const TaskGraph::TaskId id = layered.add(task);
+        if (i >= k_layer) {
+            const i32 prev_layer = i - k_layer - (i % k_layer);
+            layered.precede(prev_layer + (i % k_layer), id);
+            layered.precede(prev_layer + (i * 7 + 3) % k_layer, id);
+        }
+    }
+    layered.compile();
+
+    bench::Bench b;
+    b.batch(k_tasks).unit("task").relative(true).title(
+        ("task graph, " + std::to_string(jobs.workerCount()) + " workers").c_str());
+    b.run("task graph: wide", [&] { wide.run(jobs); });
+    b.run("task graph: chain", [&] { chain.run(jobs); });
+    b.run("task graph: 32x32 layers", [&] { layered.run(jobs); });
+    useVar(sink);
+}
+
+namespace {
+    // 'al' only selects the frame allocator
+    vex::Task<i32> leafTask([[maybe_unused]] vex::Allocator al, i32 x) { co_return x + 1; }
+
+    vex::Task<i32> awaitChain(vex::Allocator al, i32 num) {
+        i32 acc = 0;
+        for (i32 i = 0; i < num; ++i)
+            acc += co_await leafTask(al, i);
+        co_return acc;
+    }
+
+    // continuation passing counterpart of awaitChain
+    void callbackStep(i32 x, const std::function<void(i32)>& done) { done(x + 1); }
+} // namespace
+
+namespace {
+    template <typename TRing>
+    vex::Task<u64> sumRing(TRing& ring, vex::CoroWaiter& waiter, i32 num) {
+        u64 sum = 0;
+        for (i32 i = 0; i < num; ++i)
+            sum += co_await vex::popWhenReady(ring, waiter);
+        co_return sum;
+    }
+} // namespace
+
+// producer resumes the consumer inline, so it parks again on the producer thread while
+// the thread that parked it before may still be checking the ring
+TEST_CASE("coroutine ring consumer", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_items = 200'000;
+    SPSCRing<u64, 64> ring;
+    CoroWaiter waiter;
+
+    JobSystem jobs(1);
+    Task<u64> consumer = sumRing(ring, waiter, k_items);
+    std::thread producer([&] {
+        for (u64 i = 1; i <= k_items; ++i) {
+            while (!ring.tryPush(i))
+                std::this_thread::yield();
+            waiter.notify();
+        }
+    });
+    const u64 sum = syncWait(jobs, consumer);
+    producer.join();
+    CHECK(sum == (u64)k_items * (k_items + 1) / 2);
+}
+
+BENCH("Measure coroutines", "[jobs]") {
+    using namespace vex;
+    constexpr i32 k_iters = 100'000;
+
+    constexpr i32 k_chain = 10'000;
+    // big enough for k_chain child frames, bump allocator never frees
+    static u8 arena_memory[2 * 1024 * 1024];
+    BumpAllocator arena(arena_memory, sizeof(arena_memory));
+    const Allocator arena_handle = arena.makeAllocatorHandle();
+
+    bench::Bench b;
+    b.batch(k_iters).unit("call").relative(true);
+
+    b.run("coroutine: create + run, bump arena frame", [&] {
+        i32 acc = 0;
+        for (i32 i = 0; i < k_iters; ++i) {
+            arena.reset();
+            Task<i32> t = leafTask(arena_handle, i);
+            t.start();
+            acc += t.result();
+        }
+        useVar(acc);
+    });
+    b.run("coroutine: create + run, malloc frame", [&] {
+        i32 acc = 0;
+        for (i32 i = 0; i < k_iters; ++i) {
+            Task<i32> t = leafTask({}, i);
+            t.start();
+            acc += t.result();
+        }
+        useVar(acc);
+    });
+    b.run("std::function: create + call, small capture", [&] {
+        i32 acc = 0;
+        for (i32 i = 0; i < k_iters; ++i) {
+            std::function<i32()> fn = [i] { return i + 1; };
+            useVar(fn);
+            acc += fn();
+        }
+        useVar(acc);
+    });
+    b.run("std::function: create + call, 32 byte capture", [&] {
+        i32 acc = 0;
+        u64 pad[4] = {1, 2, 3, 4};
+        for (i32 i = 0; i < k_iters; ++i) {
+            std::function<i32()> fn = [i, pad] { return i + (i32)pad[i & 3]; };
+            useVar(fn);
+            acc += fn();
+        }
+        useVar(acc);
+    });
+
+    // per await cost: one parent frame awaits k_chain children
+    bench::Bench chain;
+    chain.batch(k_chain).unit("step").relative(true);
+    chain.run("coroutine: co_await child, bump arena frames", [&] {
+        arena.reset();
+        Task<i32> t = awaitChain(arena_handle, k_chain);
+        t.start();
+        useVar(t.result());
+    });
+    chain.run("std::function: callback per step", [&] {
+        i32 acc = 0;
+        const std::function<void(i32)> done = [&acc](i32 v) { acc += v; };
+        for (i32 i = 0; i < k_chain; ++i)
+            callbackStep(i, done);
+        useVar(acc);
+    });
+}
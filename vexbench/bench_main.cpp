@@ -1,41 +1,74 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench/nanobench.h>
 #include <vexcore/utils/HashUtils.h>
+#include <vexcore/utils/SimdKernels.h>
+#include <vexcore/utils/WeightedSampler.h>
 #include <vexcore/utils/VUtilsBase.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdio>
+#include <random>
 
 #include "bench_config.h"
 
+namespace {
+    template <typename TRand>
+    void benchEngine(const char* name, size_t run_cnt) {
+        char title[96];
+        snprintf(title, sizeof(title), "rng gen: u32 %s", name);
+        gBench.run(title, [&] {
+            auto rng1 = TRand::make(12345);
+            useVar(rng1);
+            for (size_t i = 0; i < run_cnt; i++) {
+                auto acc = rng1.rand();
+                useVar(acc);
+            }
+            useVar(rng1);
+        });
+        snprintf(title, sizeof(title), "rng gen: u64 %s", name);
+        gBench.run(title, [&] {
+            auto rng1 = TRand::make(12345);
+            useVar(rng1);
+            for (size_t i = 0; i < run_cnt; i++) {
+                auto acc = rng1.rand64();
+                useVar(acc);
+            }
+            useVar(rng1);
+        });
+        snprintf(title, sizeof(title), "rng float gen: %s", name);
+        gBench.run(title, [&] {
+            auto rng1 = TRand::make(12345);
+            useVar(rng1);
+            for (size_t i = 0; i < run_cnt; i++) {
+                float acc = rng1.rand01();
+                useVar(acc);
+            }
+            useVar(rng1);
+        });
+    }
+} // namespace
+
 BENCH("Measure rng", "[rng]") {
-using namespace vex::rng;
+    using namespace vex::rng;
     size_t run_cnt = 10'000'000;
 
     gBench.run("rng float gen: const", [&] {
         Rand rng1;
-        useVar(rng1); 
+        useVar(rng1);
         for (int i = 0; i < run_cnt; i++) {
             float acc = rng1.rand01();
             useVar(acc);
         }
         useVar(rng1);
     });
-    gBench.run("rng gen: u32", [&] { 
-        Rand rng1;
-        useVar(rng1);
-        for (int i = 0; i < run_cnt; i++) {
-            auto acc = rng1.rand();
-            useVar(acc); 
-        }
-        useVar(rng1);
-    });
     gBench.run("rng gen: stateless", [&] {
         auto r = rand();
         useVar(r);
         for (int i = 0; i < run_cnt; i++) {
-            auto acc =  Splitmix64::stateless(12345, i);
+            auto acc = Splitmix64::stateless(12345, i);
             useVar(acc);
-        } 
+        }
     });
     gBench.run("rng gen: marsene", [&] {
         std::mt19937 mt(static_cast<uint32_t>(std::rand()));
@@ -46,6 +79,198 @@ using namespace vex::rng;
         }
         useVar(mt);
     });
+    gBench.run("rng gen: marsene64", [&] {
+        std::mt19937_64 mt(static_cast<uint64_t>(std::rand()));
+        useVar(mt);
+        for (size_t i = 0; i < run_cnt; i++) {
+            auto acc = mt();
+            useVar(acc);
+        }
+        useVar(mt);
+    });
+
+    benchEngine<Rand>("splitmix64", run_cnt);
+    benchEngine<RandXoshiro256>("xoshiro256**", run_cnt);
+    benchEngine<RandXoshiro128>("xoshiro128+", run_cnt);
+    benchEngine<RandPcg32>("pcg32", run_cnt);
+
+    // batch: 8 SIMD lanes per call, same output on every isa
+    {
+        vex::Buffer<u32> ints;
+        vex::Buffer<float> floats;
+        ints.addUninitialized((i32)run_cnt);
+        floats.addUninitialized((i32)run_cnt);
+        const auto detected = vex::simd::detectedIsa();
+        for (auto isa : {vex::simd::EIsa::Scalar, vex::simd::EIsa::SSE2, vex::simd::EIsa::AVX2}) {
+            if ((u8)isa > (u8)detected)
+                continue;
+            vex::simd::forceIsa(isa);
+            char title[96];
+            snprintf(title, sizeof(title), "rng batch: u32 %s", vex::simd::isaName(isa));
+            gBench.run(title, [&] {
+                auto rng1 = Rand::make(12345);
+                rng1.fill(ints.data(), ints.size());
+                useVar(ints[ints.size() - 1]);
+            });
+            snprintf(title, sizeof(title), "rng batch: float %s", vex::simd::isaName(isa));
+            gBench.run(title, [&] {
+                auto rng1 = Rand::make(12345);
+                rng1.fill01(floats.data(), floats.size());
+                useVar(floats[floats.size() - 1]);
+            });
+        }
+        vex::simd::forceIsa(detected);
+    }
+
+    // per-worker stream setup cost, dominated by jump() of xoshiro
+    gBench.run("rng streams: 64 x xoshiro256**", [&] {
+        auto streams = RandXoshiro256::makeStreams(12345, 64);
+        useVar(streams[63]);
+    });
+    gBench.run("rng streams: 64 x pcg32", [&] {
+        auto streams = RandPcg32::makeStreams(12345, 64);
+        useVar(streams[63]);
+    });
+}
+
+BENCH("Measure rng distributions", "[rng]") {
+    using namespace vex::rng;
+    constexpr i32 run_cnt = 10'000'000;
+    constexpr u32 k_bound = 1'000'003;
+
+    gBench.run("rng bounded: modulo", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = rng1.rand() % k_bound;
+            useVar(acc);
+        }
+    });
+    gBench.run("rng bounded: lemire", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = rng1.randMod(k_bound);
+            useVar(acc);
+        }
+    });
+    gBench.run("rng bounded: std uniform_int", [&] {
+        std::mt19937 mt(12345);
+        std::uniform_int_distribution<int> dist(-500, 499);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = dist(mt);
+            useVar(acc);
+        }
+    });
+    gBench.run("rng bounded: randRange", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = rng1.randRange(-500, 500);
+            useVar(acc);
+        }
+    });
+
+    gBench.run("rng normal: std", [&] {
+        std::mt19937 mt(12345);
+        std::normal_distribution<float> dist;
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = dist(mt);
+            useVar(acc);
+        }
+    });
+    gBench.run("rng normal: ziggurat", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = rng1.randNormal();
+            useVar(acc);
+        }
+    });
+    gBench.run("rng exponential: std", [&] {
+        std::mt19937 mt(12345);
+        std::exponential_distribution<float> dist;
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = dist(mt);
+            useVar(acc);
+        }
+    });
+    gBench.run("rng exponential: ziggurat", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            auto acc = rng1.randExponential();
+            useVar(acc);
+        }
+    });
+
+    vex::Buffer<u32> items;
+    for (i32 i = 0; i < 1'000'000; i++)
+        items.add((u32)i);
+    gBench.run("rng shuffle 1M: std", [&] {
+        std::mt19937 mt(12345);
+        std::shuffle(items.begin(), items.end(), mt);
+        useVar(items[0]);
+    });
+    gBench.run("rng shuffle 1M: vex", [&] {
+        auto rng1 = Rand::make(12345);
+        rng1.shuffle(items);
+        useVar(items[0]);
+    });
+}
+
+BENCH("Measure weighted sampling", "[rng]") {
+    using namespace vex::rng;
+    constexpr i32 k_outcomes = 4096;
+    constexpr i32 run_cnt = 1'000'000;
+    // linear scan is too slow for full run, per-draw numbers are comparable thanks to batch
+    constexpr i32 scan_cnt = 10'000;
+
+    auto init_rng = Rand::make(777);
+    vex::Buffer<float> weights;
+    vex::Buffer<float> cdf;
+    float acc_weight = 0.0f;
+    for (i32 i = 0; i < k_outcomes; i++) {
+        const float w = init_rng.randExponential();
+        weights.add(w);
+        acc_weight += w;
+        cdf.add(acc_weight);
+    }
+
+    bench::Bench b;
+    b.unit("draw");
+    b.batch(scan_cnt).run("weighted: linear cdf scan", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < scan_cnt; i++) {
+            const float target = rng1.rand01() * acc_weight;
+            i32 picked = 0;
+            while (picked < k_outcomes - 1 && cdf[picked] <= target)
+                picked++;
+            useVar(picked);
+        }
+    });
+    b.batch(run_cnt).run("weighted: binary search cdf", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            const float target = rng1.rand01() * acc_weight;
+            auto it = std::upper_bound(cdf.begin(), cdf.end(), target);
+            i32 picked = (i32)(it - cdf.begin());
+            useVar(picked);
+        }
+    });
+
+    vex::WeightedSampler sampler;
+    b.batch(k_outcomes).unit("weight").run("weighted: alias build", [&] {
+        sampler.build(weights.constSpan());
+        useVar(sampler);
+    });
+    b.batch(run_cnt).unit("draw").run("weighted: alias sample", [&] {
+        auto rng1 = Rand::make(12345);
+        for (i32 i = 0; i < run_cnt; i++) {
+            i32 picked = sampler.sample(rng1);
+            useVar(picked);
+        }
+    });
+    b.batch(1000).unit("update").run("weighted: alias setWeight", [&] {
+        for (i32 i = 0; i < 1000; i++)
+            sampler.setWeight((i * 97) % k_outcomes, (f64)(i % 13));
+        useVar(sampler);
+    });
 }
 
 int main(int argc, char** argv) {
@@ -55,7 +280,11 @@ int main(int argc, char** argv) {
     }
 
     args->arguments.push_back({"--verbosity", "quiet", "quiet"});
-    args->arguments.push_back({{}, {"test regex"}, "[rng]"});
+    // run rng benches by default, other groups are selected from command line, e.g. "[queue]"
+    const bool has_filter = std::any_of(args->arguments.begin(), args->arguments.end(),
+        [](const snitch::cli::argument& a) { return a.value_name == "test regex"; });
+    if (!has_filter)
+        args->arguments.push_back({{}, {"test regex"}, "[rng]"});
     // args->arguments.push_back({ {}, {"test regex"}, "[wgpu]" });
     snitch::tests.configure(*args);
 
@@ -0,0 +1,175 @@
+#include <nanobench/nanobench.h>
+#include <vexcore/containers/ConcurrentRing.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_config.h"
+
+// spin loops yield, so results stay meaningful when threads share a core
+BENCH("Measure spsc", "[queue]") {
+    using namespace vex;
+    constexpr i32 k_items = 10'000'000;
+    constexpr i32 k_batch = 64;
+    using Ring = SPSCRing<u64, 4096>;
+
+    bench::Bench b;
+    b.batch(k_items).unit("item").epochs(3);
+
+    b.run("spsc throughput: single", [&] {
+        auto ring = std::make_unique<Ring>();
+        std::thread producer([&] {
+            for (u64 i = 0; i < k_items; ++i) {
+                while (!ring->tryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        u64 acc = 0;
+        for (i32 i = 0; i < k_items; ++i) {
+            u64 v = 0;
+            while (!ring->tryPop(v)) {
+                std::this_thread::yield();
+            }
+            acc += v;
+        }
+        producer.join();
+        useVar(acc);
+    });
+
+    b.run("spsc throughput: bulk 64", [&] {
+        auto ring = std::make_unique<Ring>();
+        std::thread producer([&] {
+            u64 src[k_batch];
+            for (i32 sent = 0; sent < k_items;) {
+                const i32 num = (k_items - sent) < k_batch ? (k_items - sent) : k_batch;
+                for (i32 i = 0; i < num; ++i)
+                    src[i] = (u64)(sent + i);
+                i32 pushed = 0;
+                while (pushed < num) {
+                    const i32 n = ring->tryPushN(src + pushed, num - pushed);
+                    if (n == 0)
+                        std::this_thread::yield();
+                    pushed += n;
+                }
+                sent += num;
+            }
+        });
+        u64 acc = 0;
+        u64 dst[k_batch];
+        for (i32 received = 0; received < k_items;) {
+            const i32 num = ring->tryPopN(RawBuffer<u64>(dst, k_batch));
+            if (num == 0)
+                std::this_thread::yield();
+            for (i32 i = 0; i < num; ++i)
+                acc += dst[i];
+            received += num;
+        }
+        producer.join();
+        useVar(acc);
+    });
+
+    // round trip through two rings, reported per round trip
+    constexpr i32 k_round_trips = 1'000'000;
+    bench::Bench lat;
+    lat.batch(k_round_trips).unit("round trip").epochs(3);
+    lat.run("spsc latency: ping-pong", [&] {
+        auto ping = std::make_unique<Ring>();
+        auto pong = std::make_unique<Ring>();
+        std::thread echo([&] {
+            for (i32 i = 0; i < k_round_trips; ++i) {
+                u64 v = 0;
+                while (!ping->tryPop(v)) {
+                    std::this_thread::yield();
+                }
+                while (!pong->tryPush(v)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (u64 i = 0; i < k_round_trips; ++i) {
+            ping->tryPush(i);
+            u64 v = 0;
+            while (!pong->tryPop(v)) {
+                std::this_thread::yield();
+            }
+            useVar(v);
+        }
+        echo.join();
+    });
+}
+
+namespace {
+    // baseline: what job dispatch uses now
+    template <typename T>
+    struct LockedDeque {
+        void push(T val) {
+            {
+                std::lock_guard lock(mtx);
+                items.push_back(val);
+            }
+            not_empty.notify_one();
+        }
+        T pop() {
+            std::unique_lock lock(mtx);
+            not_empty.wait(lock, [this] { return !items.empty(); });
+            T val = items.front();
+            items.pop_front();
+            return val;
+        }
+
+        std::mutex mtx;
+        std::condition_variable not_empty;
+        std::deque<T> items;
+    };
+
+    // n producers and n consumers pass k_items values in total through the queue
+    template <typename TQueue>
+    void runFanInFanOut(TQueue& queue, i32 threads, i32 items) {
+        const i32 per_thread = items / threads;
+        std::vector<std::thread> workers;
+        workers.reserve(threads * 2);
+        std::atomic<u64> total{0};
+        for (i32 t = 0; t < threads; ++t) {
+            workers.emplace_back([&queue, per_thread] {
+                for (i32 i = 0; i < per_thread; ++i)
+                    queue.push((u64)i);
+            });
+            workers.emplace_back([&queue, &total, per_thread] {
+                u64 acc = 0;
+                for (i32 i = 0; i < per_thread; ++i)
+                    acc += queue.pop();
+                total.fetch_add(acc, std::memory_order_relaxed);
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+        useVar(total);
+    }
+} // namespace
+
+BENCH("Measure mpmc", "[queue]") {
+    using namespace vex;
+    constexpr i32 k_items = 1 << 20;
+    using Ring = MPMCRing<u64, 1024>;
+
+    bench::Bench b;
+    b.batch(k_items).unit("item").epochs(3).relative(true);
+
+    for (i32 threads : {1, 2, 4, 8, 16, 32, 64}) {
+        const std::string suffix = std::to_string(threads) + "p/" + std::to_string(threads) + "c";
+        b.run("locked deque: " + suffix, [&] {
+            LockedDeque<u64> queue;
+            runFanInFanOut(queue, threads, k_items);
+        });
+        b.run("mpmc ring blocking: " + suffix, [&] {
+            auto queue = std::make_unique<Ring>();
+            runFanInFanOut(*queue, threads, k_items);
+        });
+    }
+}
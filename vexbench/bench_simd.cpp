@@ -0,0 +1,148 @@
+#include <vexcore/utils/Rng.h>
+#include <vexcore/utils/SimdKernels.h>
+
+#include <cmath>
+#include <vector>
+
+#include "bench_config.h"
+
+namespace {
+    using namespace vex;
+
+    template <typename T>
+    struct KernelCase {
+        std::vector<T> a, b, c;
+    };
+
+    // small values, so i32 mulAdd reference does not overflow
+    KernelCase<f32> makeF32(i32 num, rng::Rand& rng) {
+        KernelCase<f32> k;
+        for (i32 i = 0; i < num; ++i) {
+            k.a.push_back(rng.randRange(-100.0f, 100.0f));
+            k.b.push_back(rng.randRange(-100.0f, 100.0f));
+            k.c.push_back((f32)rng.randRange(-8, 8)); // repeats for find/count
+        }
+        return k;
+    }
+    KernelCase<i32> makeI32(i32 num, rng::Rand& rng) {
+        KernelCase<i32> k;
+        for (i32 i = 0; i < num; ++i) {
+            k.a.push_back(rng.randRange(-30'000, 30'000));
+            k.b.push_back(rng.randRange(-30'000, 30'000));
+            k.c.push_back(rng.randRange(-8, 8));
+        }
+        return k;
+    }
+
+    template <typename T>
+    i32 refFind(const T* src, i32 num, T val) {
+        for (i32 i = 0; i < num; ++i)
+            if (src[i] == val)
+                return i;
+        return -1;
+    }
+    template <typename T>
+    i32 refCount(const T* src, i32 num, T val) {
+        i32 count = 0;
+        for (i32 i = 0; i < num; ++i)
+            count += src[i] == val ? 1 : 0;
+        return count;
+    }
+
+    // every kernel on [offset, offset + num) of both element types against plain loops
+    bool checkKernels(i32 offset, i32 num, rng::Rand& rng) {
+        bool ok = true;
+        const i32 total = offset + num;
+
+        const KernelCase<f32> f = makeF32(total, rng);
+        const f32* fa = f.a.data() + offset;
+        const f32* fc = f.c.data() + offset;
+        f32 f_min = INFINITY;
+        f32 f_max = -INFINITY;
+        for (i32 i = 0; i < num; ++i) {
+            f_min = fa[i] < f_min ? fa[i] : f_min;
+            f_max = fa[i] > f_max ? fa[i] : f_max;
+        }
+        ok &= simd::min(fa, num) == f_min;
+        ok &= simd::max(fa, num) == f_max;
+        for (f32 val : {-3.0f, 0.0f, 7.0f, 100.5f}) {
+            ok &= simd::findFirst(fc, num, val) == refFind(fc, num, val);
+            ok &= simd::countEqual(fc, num, val) == refCount(fc, num, val);
+        }
+
+        std::vector<f32> f_out(total, 1.0f);
+        simd::fill(f_out.data() + offset, num, 2.5f);
+        for (i32 i = 0; i < total; ++i)
+            ok &= f_out[i] == (i < offset ? 1.0f : 2.5f);
+
+        // fused on avx2, so up to one rounding of difference
+        simd::mulAdd(f_out.data() + offset, fa, f.b.data() + offset, fc, num);
+        for (i32 i = 0; i < num; ++i) {
+            const f32 ref = fa[i] * f.b[offset + i] + fc[i];
+            ok &= std::fabs(f_out[offset + i] - ref) <= 1e-5f * (1.0f + std::fabs(ref));
+        }
+
+        const KernelCase<i32> n = makeI32(total, rng);
+        const i32* na = n.a.data() + offset;
+        const i32* nc = n.c.data() + offset;
+        i64 n_sum = 0;
+        i32 n_min = INT32_MAX;
+        i32 n_max = INT32_MIN;
+        for (i32 i = 0; i < num; ++i) {
+            n_sum += na[i];
+            n_min = na[i] < n_min ? na[i] : n_min;
+            n_max = na[i] > n_max ? na[i] : n_max;
+        }
+        ok &= simd::sum(na, num) == n_sum;
+        ok &= simd::min(na, num) == n_min;
+        ok &= simd::max(na, num) == n_max;
+        for (i32 val : {-3, 0, 7, 100}) {
+            ok &= simd::findFirst(nc, num, val) == refFind(nc, num, val);
+            ok &= simd::countEqual(nc, num, val) == refCount(nc, num, val);
+        }
+
+        std::vector<i32> n_out(total, 1);
+        simd::fill(n_out.data() + offset, num, -9);
+        for (i32 i = 0; i < total; ++i)
+            ok &= n_out[i] == (i < offset ? 1 : -9);
+        simd::mulAdd(n_out.data() + offset, na, n.b.data() + offset, nc, num);
+        for (i32 i = 0; i < num; ++i)
+            ok &= n_out[offset + i] == na[i] * n.b[offset + i] + nc[i];
+        return ok;
+    }
+} // namespace
+
+TEST_CASE("simd kernels match scalar", "[simd]") {
+    const simd::EIsa detected = simd::detectedIsa();
+    // f32 sum has the same 8-lane order on every path, so it is compared bitwise to scalar
+    std::vector<f32> sums;
+    for (simd::EIsa isa : {simd::EIsa::Scalar, simd::EIsa::SSE2, simd::EIsa::AVX2}) {
+        if ((u8)isa > (u8)detected)
+            continue;
+        simd::forceIsa(isa);
+        CHECK(simd::activeIsa() == isa);
+
+        auto rng = rng::Rand::make(11);
+        bool ok = true;
+        // tails of every length around vector widths, unaligned starts
+        for (i32 offset : {0, 1, 3, 5}) {
+            for (i32 num = 0; num <= 70; ++num)
+                ok &= checkKernels(offset, num, rng);
+            ok &= checkKernels(offset, 1001, rng);
+        }
+        CHECK(ok);
+
+        auto sum_rng = rng::Rand::make(12);
+        const KernelCase<f32> f = makeF32(4099, sum_rng);
+        for (i32 offset : {0, 1, 3})
+            for (i32 num : {0, 1, 7, 8, 9, 31, 33, 4096})
+                sums.push_back(simd::sum(f.a.data() + offset, num));
+    }
+    simd::forceIsa(detected);
+
+    const size_t per_isa = sums.size() / ((size_t)detected + 1);
+    bool same_sums = true;
+    for (size_t i = per_isa; i < sums.size(); ++i)
+        same_sums &= sums[i] == sums[i % per_isa];
+    CHECK(same_sums);
+}
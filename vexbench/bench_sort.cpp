@@ -0,0 +1,61 @@
+#include <nanobench/nanobench.h>
+#include <vexcore/jobs/JobSystem.h>
+#include <vexcore/utils/Sort.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "bench_config.h"
+
+namespace {
+    template <typename T, typename TGen>
+    void benchSortType(const char* type_name, vex::JobSystem& jobs, TGen&& gen) {
+        using namespace vex;
+        // every run copies unsorted input first, copy cost is the same for all variants
+        for (i32 num : {1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000}) {
+            Buffer<T> source;
+            source.addUninitialized(num);
+            for (i32 i = 0; i < num; ++i)
+                source[i] = gen(i);
+            Buffer<T> work;
+            work.addUninitialized(num);
+
+            bench::Bench b;
+            b.batch(num).unit("elem").relative(true).title(
+                (std::string(type_name) + " x " + std::to_string(num)).c_str());
+            if (num >= 10'000'000)
+                b.epochs(1).warmup(0);
+
+            b.run("std::sort", [&] {
+                memcpy(work.data(), source.data(), num * sizeof(T));
+                std::sort(work.begin(), work.end(), sort_impl::RadixLess<T>{});
+                useVar(work[0]);
+            });
+            b.run("vex::sort", [&] {
+                memcpy(work.data(), source.data(), num * sizeof(T));
+                vex::sort(work);
+                useVar(work[0]);
+            });
+            b.run("vex::sort, jobs", [&] {
+                memcpy(work.data(), source.data(), num * sizeof(T));
+                vex::sort(work, jobs);
+                useVar(work[0]);
+            });
+        }
+    }
+} // namespace
+
+BENCH("Measure sort", "[sort]") {
+    using namespace vex;
+    JobSystem jobs;
+    std::mt19937_64 rng(42);
+
+    benchSortType<u32>("u32", jobs, [&](i32) { return (u32)rng(); });
+    benchSortType<f32>("f32", jobs, [&](i32) {
+        return std::uniform_real_distribution<f32>(-1000.0f, 1000.0f)(rng);
+    });
+    benchSortType<KeyIndex<u32>>("KeyIndex<u32>", jobs, [&](i32 i) {
+        return KeyIndex<u32>{(u32)rng(), (u32)i};
+    });
+}
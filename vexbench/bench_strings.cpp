@@ -0,0 +1,279 @@
+#include <nanobench/nanobench.h>
+#include <vexcore/containers/Dict.h>
+#include <vexcore/containers/FrozenMap.h>
+#include <vexcore/containers/StringTable.h>
+#include <vexcore/utils/Rng.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_config.h"
+
+namespace {
+    using namespace vex;
+
+    enum class ECommand : u8 {
+        Quit, Help, Load, Save, Reload, Run, Stop, Pause, Resume, Step,
+        Break, Watch, Print, Set, Get, Echo, Clear, History, Alias, Bind,
+        Screenshot, ToggleConsole, ToggleStats, ToggleWireframe,
+    };
+    // command name table, typical FrozenMap use
+    constexpr FrozenEntry<std::string_view, ECommand> k_command_entries[] = {
+        {"quit", ECommand::Quit}, {"help", ECommand::Help}, {"load", ECommand::Load},
+        {"save", ECommand::Save}, {"reload", ECommand::Reload}, {"run", ECommand::Run},
+        {"stop", ECommand::Stop}, {"pause", ECommand::Pause}, {"resume", ECommand::Resume},
+        {"step", ECommand::Step}, {"break", ECommand::Break}, {"watch", ECommand::Watch},
+        {"print", ECommand::Print}, {"set", ECommand::Set}, {"get", ECommand::Get},
+        {"echo", ECommand::Echo}, {"clear", ECommand::Clear}, {"history", ECommand::History},
+        {"alias", ECommand::Alias}, {"bind", ECommand::Bind},
+        {"screenshot", ECommand::Screenshot}, {"toggle_console", ECommand::ToggleConsole},
+        {"toggle_stats", ECommand::ToggleStats},
+        {"toggle_wireframe", ECommand::ToggleWireframe},
+    };
+    constexpr auto k_commands = makeFrozenMap(k_command_entries);
+
+    static_assert(*k_commands.find("toggle_wireframe") == ECommand::ToggleWireframe);
+    static_assert(!k_commands.contains("toggle_"));
+    static_assert(k_commands.valueOr("", ECommand::Help) == ECommand::Help);
+
+    // tag/attribute-like names
+    std::vector<std::string> makeNames(i32 num) {
+        std::vector<std::string> names;
+        char buf[64];
+        for (i32 i = 0; i < num; ++i)
+            names.emplace_back(buf, snprintf(buf, sizeof(buf), "attr_%d_color", i));
+        return names;
+    }
+} // namespace
+
+TEST_CASE("string table", "[strings]") {
+    constexpr i32 k_names = 50'000;
+    const std::vector<std::string> names = makeNames(k_names);
+
+    // small arena, so it grows many times
+    StringTable table(64);
+    std::vector<StringId> ids;
+    for (const std::string& name : names)
+        ids.push_back(table.intern(name));
+    CHECK(table.size() == k_names);
+
+    bool same = true;
+    for (i32 i = 0; i < k_names; ++i) {
+        same &= table.intern(names[i]) == ids[i];
+        same &= table.find(names[i]) == ids[i];
+        same &= table.view(ids[i]) == names[i];
+        same &= table.cstr(ids[i])[names[i].size()] == '\0';
+    }
+    CHECK(same);
+    CHECK(ids[0] != ids[1]);
+    CHECK(!table.find("not interned").isValid());
+
+    const StringId empty = table.intern("");
+    CHECK(empty.isValid());
+    CHECK(table.view(empty).empty());
+
+    // bigger than any arena node so far
+    const std::string long_str(100'000, 'x');
+    CHECK(table.view(table.intern(long_str)) == long_str);
+
+    // ids as Dict keys
+    Dict<StringId, i32> by_id;
+    for (i32 i = 0; i < k_names; ++i)
+        by_id.emplace(ids[i], i);
+    CHECK(*by_id.find(table.find("attr_777_color")) == 777);
+
+    // every thread interns all names in its own order, ids have to agree
+    constexpr i32 k_threads = 4;
+    ConcurrentStringTable shared(1024);
+    std::vector<std::vector<StringId>> thread_ids(k_threads);
+    std::vector<std::thread> threads;
+    for (i32 t = 0; t < k_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto& out = thread_ids[t];
+            out.resize(k_names);
+            auto rng = rng::Rand::make(t + 1);
+            std::vector<i32> order(k_names);
+            for (i32 i = 0; i < k_names; ++i)
+                order[i] = i;
+            rng.shuffle(order.data(), k_names);
+            for (i32 i : order)
+                out[i] = shared.intern(names[i]);
+        });
+    }
+    for (std::thread& th : threads)
+        th.join();
+
+    CHECK(shared.size() == k_names);
+    bool agree = true;
+    for (i32 i = 0; i < k_names; ++i) {
+        for (i32 t = 1; t < k_threads; ++t)
+            agree &= thread_ids[t][i] == thread_ids[0][i];
+        agree &= shared.view(thread_ids[0][i]) == names[i];
+        agree &= shared.find(names[i]) == thread_ids[0][i];
+    }
+    CHECK(agree);
+}
+
+BENCH("Measure string interning", "[strings]") {
+    constexpr i32 k_names = 100'000;
+    const std::vector<std::string> names = makeNames(k_names);
+    std::vector<i32> order(k_names);
+    for (i32 i = 0; i < k_names; ++i)
+        order[i] = i;
+    auto rng = rng::Rand::make(3);
+    rng.shuffle(order.data(), k_names);
+
+    {
+        bench::Bench b;
+        b.batch(k_names).unit("string").relative(true);
+        b.title("intern, all new strings");
+        b.run("StringTable", [&] {
+            StringTable table;
+            for (const std::string& name : names)
+                useVar(table.intern(name));
+        });
+        b.run("ConcurrentStringTable", [&] {
+            ConcurrentStringTable table;
+            for (const std::string& name : names)
+                useVar(table.intern(name));
+        });
+    }
+
+    StringTable table;
+    ConcurrentStringTable shared;
+    std::vector<StringId> ids;
+    for (const std::string& name : names) {
+        ids.push_back(table.intern(name));
+        shared.intern(name);
+    }
+    {
+        bench::Bench b;
+        b.batch(k_names).unit("string").relative(true);
+        b.title("intern, already interned");
+        b.run("StringTable", [&] {
+            for (i32 i : order)
+                useVar(table.intern(names[i]));
+        });
+        b.run("ConcurrentStringTable", [&] {
+            for (i32 i : order)
+                useVar(shared.intern(names[i]));
+        });
+        for (i32 num_threads : {2, 4}) {
+            b.batch((size_t)k_names * num_threads);
+            b.run("ConcurrentStringTable, threads: " + std::to_string(num_threads), [&] {
+                std::vector<std::thread> threads;
+                for (i32 t = 0; t < num_threads; ++t) {
+                    threads.emplace_back([&] {
+                        for (i32 i : order)
+                            useVar(shared.intern(names[i]));
+                    });
+                }
+                for (std::thread& th : threads)
+                    th.join();
+            });
+        }
+    }
+
+    // what tag/attribute maps gain from switching keys to ids
+    Dict<std::string, i32> by_string;
+    Dict<StringId, i32> by_id;
+    for (i32 i = 0; i < k_names; ++i) {
+        by_string.emplace(names[i], i);
+        by_id.emplace(ids[i], i);
+    }
+    {
+        bench::Bench b;
+        b.batch(k_names).unit("find").relative(true);
+        b.title("Dict find, shuffled");
+        b.run("Dict<std::string>", [&] {
+            i64 acc = 0;
+            for (i32 i : order)
+                acc += *by_string.find(names[i]);
+            useVar(acc);
+        });
+        b.run("Dict<StringId>", [&] {
+            i64 acc = 0;
+            for (i32 i : order)
+                acc += *by_id.find(ids[i]);
+            useVar(acc);
+        });
+    }
+}
+
+TEST_CASE("frozen map", "[strings]") {
+    bool all_found = true;
+    for (const auto& e : k_command_entries) {
+        const ECommand* v = k_commands.find(std::string(e.key));
+        all_found &= v != nullptr && *v == e.value;
+    }
+    CHECK(all_found);
+    CHECK(!k_commands.contains("Quit"));
+    CHECK(!k_commands.contains("quit "));
+
+    // built at runtime through the same code, sparse int keys
+    constexpr u32 k_keys = 2000;
+    static FrozenEntry<u32, u32> entries[k_keys];
+    for (u32 i = 0; i < k_keys; ++i)
+        entries[i] = {i << 12, i};
+    const auto ints = std::make_unique<FrozenMap<u32, u32, k_keys>>(entries);
+    bool ints_ok = true;
+    for (u32 i = 0; i < k_keys; ++i) {
+        ints_ok &= *ints->find(i << 12) == i;
+        ints_ok &= !ints->contains((i << 12) + 1);
+    }
+    CHECK(ints_ok);
+}
+
+BENCH("Measure frozen map find", "[strings]") {
+    constexpr i32 k_lookups = 100'000;
+    constexpr i32 k_num = (i32)std::size(k_command_entries);
+
+    // mostly hits, every 4th lookup misses
+    std::vector<std::string> queries;
+    auto rng = rng::Rand::make(5);
+    for (i32 i = 0; i < k_lookups; ++i) {
+        std::string q(k_command_entries[rng.randRange(0, k_num)].key);
+        if ((i & 3) == 3)
+            q += "_";
+        queries.push_back(std::move(q));
+    }
+
+    Dict<std::string_view, ECommand> dict;
+    for (const auto& e : k_command_entries)
+        dict.emplace(e.key, e.value);
+
+    bench::Bench b;
+    b.batch(k_lookups).unit("find").relative(true);
+    b.title("command name lookup");
+    b.run("linear search", [&] {
+        i32 acc = 0;
+        for (const std::string& q : queries) {
+            for (const auto& e : k_command_entries) {
+                if (e.key == q) {
+                    acc += (i32)e.value;
+                    break;
+                }
+            }
+        }
+        useVar(acc);
+    });
+    b.run("Dict<std::string_view>", [&] {
+        i32 acc = 0;
+        for (const std::string& q : queries) {
+            if (const ECommand* v = dict.find(std::string_view(q)))
+                acc += (i32)*v;
+        }
+        useVar(acc);
+    });
+    b.run("FrozenMap", [&] {
+        i32 acc = 0;
+        for (const std::string& q : queries) {
+            if (const ECommand* v = k_commands.find(q))
+                acc += (i32)*v;
+        }
+        useVar(acc);
+    });
+}
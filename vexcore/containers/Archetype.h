@@ -0,0 +1,281 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/SOABuffer.h>
+#include <vexcore/containers/SlotMap.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <tuple>
+
+namespace vex {
+    using Entity = SlotHandle32;
+
+    /*
+     * Storage for all entities that share the same set of components.
+     * Rows live in fixed-size chunks (k_chunk_bytes), every chunk is one SOAUniBuffer with
+     * Entity column followed by one column per component, so systems iterate raw column
+     * pointers chunk by chunk. Rows are kept packed: removal moves the last row into the hole.
+     *
+     * Row index is global for the archetype: chunk = row / k_chunk_capacity.
+     * Archetype does not know where entities are, removal and moves return the entity that
+     * changed its row so owner can patch its entity -> (archetype, row) records.
+     */
+    template <typename... TComponents>
+    class Archetype {
+    public:
+        static_assert(sizeof...(TComponents) > 0, "empty archetype");
+        static_assert(!traits::hasType<Entity, TComponents...>(), "Entity is implicit column");
+
+        static constexpr u32 k_chunk_bytes = 16 * 1024;
+        static constexpr u32 k_row_bytes = (sizeof(Entity) + ... + sizeof(TComponents));
+        // every column can lose up to 'alignment' bytes on padding
+        static constexpr u32 k_padding_bytes =
+            (u32)(maxAlignOf<Entity, TComponents...>() * (sizeof...(TComponents) + 1));
+        static constexpr u32 k_chunk_capacity =
+            k_row_bytes + k_padding_bytes < k_chunk_bytes
+                ? (k_chunk_bytes - k_padding_bytes) / k_row_bytes
+                : 1;
+
+        using Chunk = SOAUniBuffer<Entity, TComponents...>;
+
+        template <typename T>
+        static constexpr bool has() {
+            return traits::hasType<T, TComponents...>();
+        }
+        template <typename... Ts>
+        static constexpr bool hasAll() {
+            return (has<Ts>() && ...);
+        }
+
+        struct MoveResult {
+            i32 dst_row = -1;
+            // entity that now occupies the vacated row in source archetype (invalid if none)
+            Entity relocated{};
+        };
+
+        Archetype() = default;
+        explicit Archetype(Allocator al) : allocator(al), chunks(al) {}
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+        ~Archetype() {
+            clear();
+            // not range-for: Buffer::end() is null once shrink() has emptied 'chunks'
+            for (i32 i = 0; i < chunks.size(); ++i) {
+                chunks[i]->~Chunk();
+                vexFree(allocator, chunks[i]);
+            }
+        }
+
+        FORCE_INLINE auto size() const -> i32 { return len; }
+        FORCE_INLINE auto chunkCount() const -> i32 {
+            return (len + (i32)k_chunk_capacity - 1) / (i32)k_chunk_capacity;
+        }
+        FORCE_INLINE auto chunkSize(i32 chunk) const -> i32 {
+            const i32 rest = len - chunk * (i32)k_chunk_capacity;
+            return rest < (i32)k_chunk_capacity ? rest : (i32)k_chunk_capacity;
+        }
+
+        FORCE_INLINE auto entityAt(i32 row) const -> Entity { return *column<Entity>(row); }
+
+        template <typename T>
+        FORCE_INLINE auto get(i32 row) const -> T& {
+            static_assert(has<T>(), "archetype does not have this component");
+            checkLethal((row >= 0) && (row < len), "row is out of bounds");
+            return *column<T>(row);
+        }
+
+        // components not passed explicitly are default constructed
+        template <typename... TArgs>
+        i32 add(Entity e, TArgs&&... comps) {
+            // matched by exact type: f32 passed for f64 component would be silently dropped
+            static_assert((has<std::decay_t<TArgs>>() && ...),
+                "every argument has to be exactly one of the archetype components");
+            const i32 row = pushRow(e);
+            auto args = std::forward_as_tuple(std::forward<TArgs>(comps)...);
+            (constructFrom<TComponents>(row, args), ...);
+            return row;
+        }
+
+        // returns entity that was moved into 'row' (invalid if 'row' was the last one)
+        Entity removeSwap(i32 row) {
+            checkLethal((row >= 0) && (row < len), "row is out of bounds");
+            (destroyAt<TComponents>(row), ...);
+            return fillHole(row);
+        }
+
+        /*
+         * Structural move of row into other archetype: shared components are moved,
+         * components passed in 'extra' are constructed from args, rest of dst components are
+         * default constructed, src components that dst lacks are destroyed.
+         */
+        template <typename TDst, typename... TExtra>
+        MoveResult moveTo(i32 row, TDst& dst, TExtra&&... extra) {
+            checkLethal((row >= 0) && (row < len), "row is out of bounds");
+            static_assert((TDst::template has<std::decay_t<TExtra>>() && ...),
+                "every extra argument has to be exactly one of the destination components");
+            checkLethal((void*)&dst != (void*)this, "moving into the same archetype");
+
+            MoveResult result;
+            result.dst_row = dst.pushRow(entityAt(row));
+            auto args = std::forward_as_tuple(std::forward<TExtra>(extra)...);
+            dst.constructForMove(result.dst_row, *this, row, args);
+
+            (destroyAt<TComponents>(row), ...);
+            result.relocated = fillHole(row);
+            return result;
+        }
+
+        /*
+         * Calls func(i32 count, Ts*... columns) for every non-empty chunk.
+         * Entity can be requested as one of Ts to get entity column.
+         */
+        template <typename... Ts, typename TFunc>
+        void forEachChunk(TFunc&& func) {
+            static_assert(((has<Ts>() || std::is_same_v<Ts, Entity>)&&...),
+                "archetype does not have requested component");
+            const i32 count = chunkCount();
+            for (i32 c = 0; c < count; ++c) {
+                Chunk* chunk = chunks[c];
+                func(chunkSize(c), chunkColumn<Ts>(chunk)...);
+            }
+        }
+
+        void clear() {
+            for (i32 row = 0; row < len; ++row) {
+                (destroyAt<TComponents>(row), ...);
+            }
+            len = 0;
+        }
+
+        // releases chunks that are not used by any row
+        void shrink() {
+            const i32 used = chunkCount();
+            while (chunks.size() > used) {
+                Chunk* c = *chunks.back();
+                chunks.removeSwapAt(chunks.size() - 1);
+                c->~Chunk();
+                vexFree(allocator, c);
+            }
+        }
+
+    private:
+        template <typename... Ts>
+        friend class Archetype;
+
+        template <typename T>
+        static constexpr size_t k_column = traits::getIndex<T, Entity, TComponents...>();
+
+        template <typename T>
+        FORCE_INLINE static T* chunkColumn(Chunk* chunk) {
+            return chunk->template getBuffPtr<k_column<T>, T>();
+        }
+        template <typename T>
+        FORCE_INLINE T* column(i32 row) const {
+            return chunkColumn<T>(chunks[row / k_chunk_capacity]) + (row % k_chunk_capacity);
+        }
+
+        i32 pushRow(Entity e) {
+            if (len == chunks.size() * (i32)k_chunk_capacity) {
+                Chunk* chunk = vexAllocTyped<Chunk>(allocator, 1);
+                checkLethal(chunk, "failure of allocator");
+                new (chunk) Chunk(k_chunk_capacity);
+                chunks.add(chunk);
+            }
+            const i32 row = len++;
+            new (column<Entity>(row)) Entity(e);
+            return row;
+        }
+
+        template <typename T>
+        FORCE_INLINE void destroyAt(i32 row) {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                column<T>(row)->~T();
+        }
+
+        template <typename T, typename TArgs>
+        FORCE_INLINE void constructFrom(i32 row, TArgs& args) {
+            T* dst = column<T>(row);
+            if constexpr (hasTupleType<T, TArgs>()) {
+                using TArg = tupleElem<T, TArgs>;
+                new (dst) T(std::forward<TArg>(std::get<TArg>(args)));
+            } else
+                new (dst) T();
+        }
+
+        template <typename TSrc, typename TArgs>
+        void constructForMove(i32 row, TSrc& src, i32 src_row, TArgs& args) {
+            (constructOneForMove<TComponents>(row, src, src_row, args), ...);
+        }
+        template <typename T, typename TSrc, typename TArgs>
+        FORCE_INLINE void constructOneForMove(i32 row, TSrc& src, i32 src_row, TArgs& args) {
+            if constexpr (!hasTupleType<T, TArgs>() && TSrc::template has<T>())
+                new (column<T>(row)) T(std::move(*src.template column<T>(src_row)));
+            else
+                constructFrom<T>(row, args);
+        }
+
+        template <typename T>
+        FORCE_INLINE void moveRow(i32 from, i32 to) {
+            T* src = column<T>(from);
+            new (column<T>(to)) T(std::move(*src));
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                src->~T();
+        }
+
+        // moves last row into 'row', returns entity that was moved
+        Entity fillHole(i32 row) {
+            const i32 last = len - 1;
+            Entity relocated{};
+            if (row != last) {
+                relocated = entityAt(last);
+                *column<Entity>(row) = relocated;
+                (moveRow<TComponents>(last, row), ...);
+            }
+            len--;
+            return relocated;
+        }
+
+        // tuple of forwarded args -> matching by decayed type
+        template <typename T, typename TTuple>
+        struct TupleFind;
+        template <typename T, typename... Ts>
+        struct TupleFind<T, std::tuple<Ts...>> {
+            static constexpr size_t index = traits::getIndex<T, std::decay_t<Ts>...>();
+            static constexpr bool found = index != traits::type_index_none;
+            using Type = std::conditional_t<found,
+                std::tuple_element_t<(found ? index : 0), std::tuple<Ts..., void>>, void>;
+        };
+        template <typename T, typename TTuple>
+        static constexpr bool hasTupleType() {
+            return TupleFind<T, TTuple>::found;
+        }
+        template <typename T, typename TTuple>
+        using tupleElem = typename TupleFind<T, TTuple>::Type;
+
+        Allocator allocator;
+        Buffer<Chunk*> chunks;
+        i32 len = 0;
+    };
+
+    /*
+     * Runs func(i32 count, Ts*... columns) over every chunk of every archetype that has all
+     * of the requested components, archetypes that do not match are skipped at compile time.
+     */
+    template <typename... Ts, typename TFunc, typename... TArchetypes>
+    void queryChunks(TFunc&& func, TArchetypes&... archetypes) {
+        (
+            [&](auto& arch) {
+                using TArch = std::decay_t<decltype(arch)>;
+                if constexpr (((TArch::template has<Ts>() || std::is_same_v<Ts, Entity>)&&...))
+                    arch.template forEachChunk<Ts...>(func);
+            }(archetypes),
+            ...);
+    }
+} // namespace vex
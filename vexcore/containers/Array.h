@@ -143,7 +143,7 @@ namespace vex {
             if (num > 0) {
                 reserve(num);
                 for (i32 i = len; i < num; i++) {
-                    add({});
+                    add(ValType{});
                 }
             } else {
                 len = num;
@@ -0,0 +1,375 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/SOABuffer.h>
+#include <vexcore/containers/Union.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <atomic>
+#include <thread>
+
+namespace vex {
+    static constexpr size_t k_cache_line = 64;
+
+    /*
+        Lock-free single producer / single consumer FIFO queue with inline storage (same idea
+        as StaticRing, but with queue semantics). Exactly one thread may push and exactly one
+        (other) thread may pop.
+
+        'head' (read position) is owned by consumer, 'tail' (write position) by producer, each
+        on its own cache line together with the owner's cached copy of the opposite index, so
+        in steady state sides touch shared line only when the cached value runs out.
+        Indices are free running u32, k_capacity must be a power of 2 so wrap is a mask.
+    */
+    template <class T, i32 k_capacity>
+    class SPSCRing {
+        static_assert(k_capacity >= 2 && (k_capacity & (k_capacity - 1)) == 0,
+            "k_capacity must be a power of 2");
+        static constexpr u32 k_mask = (u32)k_capacity - 1;
+
+    public:
+        using ValueType = T;
+
+        SPSCRing() {}
+        SPSCRing(const SPSCRing&) = delete;
+        SPSCRing& operator=(const SPSCRing&) = delete;
+        ~SPSCRing() {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                const u32 t = prod.tail.load(std::memory_order_relaxed);
+                for (u32 h = cons.head.load(std::memory_order_relaxed); h != t; ++h)
+                    item(h)->~T();
+            }
+        }
+
+        inline auto capacity() const -> i32 { return k_capacity; }
+        // approximate if called while other side is active
+        inline auto size() const -> i32 {
+            const u32 t = prod.tail.load(std::memory_order_acquire);
+            const u32 h = cons.head.load(std::memory_order_acquire);
+            return (i32)(t - h);
+        }
+        inline auto isEmpty() const -> bool { return size() == 0; }
+
+        // ---------------------------------------------------------------- producer side
+        template <typename... TArgs>
+        inline bool tryEmplace(TArgs&&... args) {
+            const u32 t = prod.tail.load(std::memory_order_relaxed);
+            if (t - prod.cached_head == (u32)k_capacity) {
+                prod.cached_head = cons.head.load(std::memory_order_acquire);
+                if (t - prod.cached_head == (u32)k_capacity)
+                    return false;
+            }
+            new (item(t)) T(std::forward<TArgs>(args)...);
+            prod.tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+        template <typename TFwd>
+        inline bool tryPush(TFwd&& val) {
+            return tryEmplace(std::forward<TFwd>(val));
+        }
+
+        // pushes as many as fits, returns number of pushed elements
+        i32 tryPushN(const T* src, i32 num) {
+            const u32 t = prod.tail.load(std::memory_order_relaxed);
+            u32 free_slots = (u32)k_capacity - (t - prod.cached_head);
+            if (free_slots < (u32)num) {
+                prod.cached_head = cons.head.load(std::memory_order_acquire);
+                free_slots = (u32)k_capacity - (t - prod.cached_head);
+            }
+            const u32 cnt = (u32)num < free_slots ? (u32)num : free_slots;
+            if (cnt == 0)
+                return 0;
+
+            const u32 start = t & k_mask;
+            const u32 first_part = cnt < (u32)k_capacity - start ? cnt : (u32)k_capacity - start;
+            copyIn(start, src, first_part);
+            copyIn(0, src + first_part, cnt - first_part);
+
+            prod.tail.store(t + cnt, std::memory_order_release);
+            return (i32)cnt;
+        }
+        FORCE_INLINE i32 tryPushN(ROSpan<T> src) { return tryPushN(src.data, src.size()); }
+
+        // ---------------------------------------------------------------- consumer side
+        inline bool tryPop(T& out) {
+            const u32 h = cons.head.load(std::memory_order_relaxed);
+            if (h == cons.cached_tail) {
+                cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+                if (h == cons.cached_tail)
+                    return false;
+            }
+            T* src = item(h);
+            out = std::move(*src);
+            src->~T();
+            cons.head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+        [[nodiscard]] inline auto tryPop() -> vex::Option<T> {
+            const u32 h = cons.head.load(std::memory_order_relaxed);
+            if (h == cons.cached_tail) {
+                cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+                if (h == cons.cached_tail)
+                    return {};
+            }
+            T* src = item(h);
+            Option<T> out_val{std::move(*src)};
+            src->~T();
+            cons.head.store(h + 1, std::memory_order_release);
+            return out_val;
+        }
+        // consumer-only peek at the oldest element, nullptr if empty
+        inline auto peek() -> T* {
+            const u32 h = cons.head.load(std::memory_order_relaxed);
+            if (h == cons.cached_tail) {
+                cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+                if (h == cons.cached_tail)
+                    return nullptr;
+            }
+            return item(h);
+        }
+
+        // pops up to max_num elements into dst, returns number of popped elements
+        i32 tryPopN(T* dst, i32 max_num) {
+            const u32 h = cons.head.load(std::memory_order_relaxed);
+            u32 avail = cons.cached_tail - h;
+            if (avail < (u32)max_num) {
+                cons.cached_tail = prod.tail.load(std::memory_order_acquire);
+                avail = cons.cached_tail - h;
+            }
+            const u32 cnt = (u32)max_num < avail ? (u32)max_num : avail;
+            if (cnt == 0)
+                return 0;
+
+            const u32 start = h & k_mask;
+            const u32 first_part = cnt < (u32)k_capacity - start ? cnt : (u32)k_capacity - start;
+            copyOut(start, dst, first_part);
+            copyOut(0, dst + first_part, cnt - first_part);
+
+            cons.head.store(h + cnt, std::memory_order_release);
+            return (i32)cnt;
+        }
+        FORCE_INLINE i32 tryPopN(const RawBuffer<T>& dst) { return tryPopN(dst.first, dst.size()); }
+
+    private:
+        FORCE_INLINE T* item(u32 i) { return &data_typed[i & k_mask]; }
+
+        inline void copyIn(u32 at, const T* src, u32 num) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (num > 0)
+                    memcpy(data_typed + at, src, num * sizeof(T));
+            } else {
+                for (u32 i = 0; i < num; ++i)
+                    new (data_typed + at + i) T(src[i]);
+            }
+        }
+        inline void copyOut(u32 at, T* dst, u32 num) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (num > 0)
+                    memcpy(dst, data_typed + at, num * sizeof(T));
+            } else {
+                for (u32 i = 0; i < num; ++i) {
+                    dst[i] = std::move(data_typed[at + i]);
+                    data_typed[at + i].~T();
+                }
+            }
+        }
+
+        struct alignas(k_cache_line) ProducerState {
+            std::atomic<u32> tail{0};
+            u32 cached_head = 0;
+        };
+        struct alignas(k_cache_line) ConsumerState {
+            std::atomic<u32> head{0};
+            u32 cached_tail = 0;
+        };
+
+        ProducerState prod;
+        ConsumerState cons;
+
+        static constexpr auto k_align = alignof(T) < k_cache_line ? k_cache_line : alignof(T);
+        union {
+            alignas(k_align) byte data_bytes[k_capacity * sizeof(T)];
+            alignas(k_align) T data_typed[k_capacity];
+        };
+    };
+    /*
+        Bounded multi producer / multi consumer FIFO queue (D. Vyukov's design), T stored
+        inline. Every cell carries a sequence number that tells which lap it is in:
+            seq == pos       -> free, producer that claims 'pos' may write
+            seq == pos + 1   -> full, consumer that claims 'pos' may read
+        after reading consumer sets seq to pos + k_capacity (free for the next lap).
+        Producers and consumers only contend on their own index (CAS), cells are touched by one
+        thread at a time.
+
+        try* functions never block. push/pop block while the queue is full/empty: they take a
+        ticket (fetch_add) and wait on the cell sequence with std::atomic::wait (futex on Linux),
+        so they can't be cancelled - to stop blocked consumers push one sentinel per consumer.
+    */
+    template <class T, i32 k_capacity>
+    class MPMCRing {
+        static_assert(k_capacity >= 2 && (k_capacity & (k_capacity - 1)) == 0,
+            "k_capacity must be a power of 2");
+        static constexpr u32 k_mask = (u32)k_capacity - 1;
+        static constexpr i32 k_spins_before_wait = 64;
+        static constexpr i32 k_yields_before_wait = 8;
+
+    public:
+        using ValueType = T;
+
+        MPMCRing() {
+            for (u32 i = 0; i < (u32)k_capacity; ++i)
+                cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        MPMCRing(const MPMCRing&) = delete;
+        MPMCRing& operator=(const MPMCRing&) = delete;
+        ~MPMCRing() {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                const u32 t = tail.pos.load(std::memory_order_relaxed);
+                for (u32 h = head.pos.load(std::memory_order_relaxed); h != t; ++h)
+                    cells[h & k_mask].val.~T();
+            }
+        }
+
+        inline auto capacity() const -> i32 { return k_capacity; }
+        // approximate if called while queue is used
+        inline auto size() const -> i32 {
+            const i32 num = (i32)(tail.pos.load(std::memory_order_acquire) -
+                                  head.pos.load(std::memory_order_acquire));
+            return num < 0 ? 0 : (num > k_capacity ? k_capacity : num);
+        }
+        inline auto isEmpty() const -> bool { return size() == 0; }
+
+        // ---------------------------------------------------------------- non-blocking
+        template <typename... TArgs>
+        bool tryEmplace(TArgs&&... args) {
+            u32 pos = tail.pos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells[pos & k_mask];
+                const u32 seq = cell.seq.load(std::memory_order_acquire);
+                const i32 diff = (i32)(seq - pos);
+                if (diff == 0) {
+                    if (tail.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return publish(cell, pos, std::forward<TArgs>(args)...);
+                } else if (diff < 0) {
+                    return false; // full: cell is not consumed yet from previous lap
+                } else {
+                    pos = tail.pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        template <typename TFwd>
+        FORCE_INLINE bool tryPush(TFwd&& val) {
+            return tryEmplace(std::forward<TFwd>(val));
+        }
+
+        bool tryPop(T& out) {
+            u32 pos = 0;
+            Cell* cell = claimRead(pos);
+            if (!cell)
+                return false;
+            out = std::move(cell->val);
+            release(*cell, pos);
+            return true;
+        }
+        [[nodiscard]] inline auto tryPop() -> vex::Option<T> {
+            u32 pos = 0;
+            Cell* cell = claimRead(pos);
+            if (!cell)
+                return {};
+            Option<T> out_val{std::move(cell->val)};
+            release(*cell, pos);
+            return out_val;
+        }
+
+        // ---------------------------------------------------------------- blocking
+        template <typename... TArgs>
+        void emplace(TArgs&&... args) {
+            const u32 pos = tail.pos.fetch_add(1, std::memory_order_relaxed);
+            Cell& cell = cells[pos & k_mask];
+            waitForSeq(cell, pos);
+            publish(cell, pos, std::forward<TArgs>(args)...);
+        }
+        template <typename TFwd>
+        FORCE_INLINE void push(TFwd&& val) {
+            emplace(std::forward<TFwd>(val));
+        }
+
+        [[nodiscard]] T pop() {
+            const u32 pos = head.pos.fetch_add(1, std::memory_order_relaxed);
+            Cell& cell = cells[pos & k_mask];
+            waitForSeq(cell, pos + 1);
+            T out{std::move(cell.val)};
+            release(cell, pos);
+            return out;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<u32> seq;
+            union {
+                T val;
+            };
+            Cell() {}
+            ~Cell() {}
+        };
+
+        template <typename... TArgs>
+        FORCE_INLINE bool publish(Cell& cell, u32 pos, TArgs&&... args) {
+            new (&cell.val) T(std::forward<TArgs>(args)...);
+            cell.seq.store(pos + 1, std::memory_order_release);
+            cell.seq.notify_all();
+            return true;
+        }
+        // claims the oldest written cell, nullptr if queue is empty
+        Cell* claimRead(u32& pos) {
+            pos = head.pos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells[pos & k_mask];
+                const u32 seq = cell.seq.load(std::memory_order_acquire);
+                const i32 diff = (i32)(seq - (pos + 1));
+                if (diff == 0) {
+                    if (head.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &cell;
+                } else if (diff < 0) {
+                    return nullptr; // empty: cell is not written yet
+                } else {
+                    pos = head.pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        // destroys moved-from value and frees the cell for the next lap
+        FORCE_INLINE void release(Cell& cell, u32 pos) {
+            cell.val.~T();
+            cell.seq.store(pos + (u32)k_capacity, std::memory_order_release);
+            cell.seq.notify_all();
+        }
+
+        static void waitForSeq(Cell& cell, u32 expected) {
+            u32 seq = cell.seq.load(std::memory_order_acquire);
+            for (i32 spin = 0; seq != expected && spin < k_spins_before_wait; ++spin)
+                seq = cell.seq.load(std::memory_order_acquire);
+            // other side is likely preempted (oversubscribed), give it the core before sleeping
+            for (i32 spin = 0; seq != expected && spin < k_yields_before_wait; ++spin) {
+                std::this_thread::yield();
+                seq = cell.seq.load(std::memory_order_acquire);
+            }
+            while (seq != expected) {
+                cell.seq.wait(seq, std::memory_order_acquire);
+                seq = cell.seq.load(std::memory_order_acquire);
+            }
+        }
+
+        struct alignas(k_cache_line) Index {
+            std::atomic<u32> pos{0};
+        };
+
+        Index tail; // producers
+        Index head; // consumers
+        alignas(k_cache_line) Cell cells[k_capacity];
+    };
+} // namespace vex
@@ -57,41 +57,49 @@ namespace vex {
 
         inline static bool is_equal(const TKey& a, const TKey& b) { return a == b; }
     };
-    template <>
-    struct KeyHashEq<int> {
-        inline static i32 hash(const int& key) { return key; }
-        inline static bool is_equal(int a, int b) { return a == b; }
-    };
 
-#ifdef VEXCORE_DEFINE_STRHASH
-    template <>
-    struct KeyHashEq<std::string> {
-        inline static i32 hash(const std::string& key) {
-            return murmur::MurmurHash3_x86_32(key.data(), (int)key.size());
-        }
-        inline static i32 hash(std::string_view key) {
-            return murmur::MurmurHash3_x86_32(key.data(), (int)key.size());
-        }
-        inline static i32 hash(const char* key) {
-            return murmur::MurmurHash3_x86_32(key, strlen(key));
+    /*
+     * Integral and pointer keys go through util::mix policy before folding to i32,
+     * default Fmix64 keeps strided keys (multiples of capacity, aligned pointers) spread.
+     * Pass IntKeyHashEq<TKey, util::mix::Identity> for dense sequential ids.
+     */
+    template <typename TKey, typename TMix = util::mix::Fmix64>
+    struct IntKeyHashEq {
+        FORCE_INLINE static i32 hash(TKey key) {
+            u64 bits;
+            if constexpr (std::is_pointer_v<TKey>)
+                bits = (u64)(uintptr_t)key;
+            else
+                bits = (u64)key;
+            return util::foldHash(TMix::mix(bits));
         }
+        FORCE_INLINE static bool is_equal(TKey a, TKey b) { return a == b; }
+    };
+    template <typename TKey>
+        requires(std::is_integral_v<TKey> || std::is_enum_v<TKey> || std::is_pointer_v<TKey>)
+    struct KeyHashEq<TKey> : IntKeyHashEq<TKey> {};
+
+    // string keys share util::hash64, so std::string Dict can be searched by string_view or
+    // C string without building std::string
+    struct StringKeyHashEq {
+        inline static i32 hash(std::string_view key) { return util::hash32(key); }
+        // strlen is vectorized in libc, hashing then goes 16-48 bytes per step
+        inline static i32 hash(const char* key) { return util::hash32(key, strlen(key)); }
+        inline static i32 hash(const std::string& key) { return util::hash32(key); }
+
         template <typename T1, typename T2>
         inline static bool is_equal(const T1& a, const T2& b) {
-            return a == b;
+            return std::string_view(a) == std::string_view(b);
         }
     };
-#endif
-
     template <>
-    struct KeyHashEq<const char*> {
-        inline static i32 hash(const char* key) { return vex::util::fnv1a(key); }
-        inline static bool is_equal(const char* a, const char* b) { return strcmp(a, b) == 0; }
-    };
+    struct KeyHashEq<std::string> : StringKeyHashEq {};
     template <>
-    struct KeyHashEq<char*> {
-        inline static i32 hash(char* key) { return vex::util::fnv1a(key); }
-        inline static bool is_equal(const char* a, const char* b) { return strcmp(a, b) == 0; }
-    };
+    struct KeyHashEq<std::string_view> : StringKeyHashEq {};
+    template <>
+    struct KeyHashEq<const char*> : StringKeyHashEq {};
+    template <>
+    struct KeyHashEq<char*> : StringKeyHashEq {};
     struct DSentinel {};
     static constexpr const DSentinel kEndIteratorSentinel{};
     /*
@@ -237,6 +245,29 @@ namespace vex {
         FORCE_INLINE i32 size() const noexcept { return top_idx - free_count; }
         FORCE_INLINE u32 capacity() const noexcept { return data.capacity; }
 
+        struct ChainStats {
+            i32 used_buckets = 0;
+            i32 max_chain = 0;
+            f32 avg_chain = 0.0f; // over used buckets, 1.0 is ideal
+        };
+        // walks every bucket, meant for diagnostics and hasher selection, not for hot paths
+        ChainStats chainStats() const noexcept {
+            ChainStats stats;
+            i64 total = 0;
+            for (u32 b = 0; b < capacity(); ++b) {
+                i32 len = 0;
+                for (i32 i = data.buckets[b]; i >= 0; i = data.blocks[i].next)
+                    len++;
+                if (len > 0) {
+                    stats.used_buckets++;
+                    total += len;
+                    stats.max_chain = len > stats.max_chain ? len : stats.max_chain;
+                }
+            }
+            stats.avg_chain = stats.used_buckets > 0 ? (f32)total / stats.used_buckets : 0.0f;
+            return stats;
+        }
+
         Dict(u32 in_capacity = 7, vex ::Allocator in_alloc = {})
         : data(in_alloc, vex::util::closestPrimeSearch(in_capacity)) {
             refreshState();
@@ -0,0 +1,208 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/HashUtils.h>
+#include <vexcore/utils/Rng.h>
+
+#include <string.h>
+
+#include <array>
+#include <bit>
+#include <string_view>
+#include <type_traits>
+
+namespace vex {
+    namespace frozen_detail {
+        // not constexpr on purpose: reaching them during constant evaluation fails the build
+        inline void duplicateKeyInFrozenMap() { checkLethal(false, "duplicate key"); }
+        inline void frozenMapSeedSearchFailed() { checkLethal(false, "no perfect hash found"); }
+
+        // little-endian, same value in constant evaluation and at runtime
+        constexpr u64 readBytes(const char* p, size_t num) {
+            if (!std::is_constant_evaluated() && num == 8) {
+                u64 v;
+                memcpy(&v, p, sizeof(v));
+                return v;
+            }
+            u64 v = 0;
+            for (size_t i = 0; i < num; ++i)
+                v |= (u64)(u8)p[i] << (8 * i);
+            return v;
+        }
+
+        // seeded hashes usable in constexpr (util::hash64 is not: memcpy, 128-bit multiply)
+        constexpr u64 hashKey(std::string_view key, u64 seed) {
+            u64 h = seed ^ ((u64)key.size() * util::k_hash_p0);
+            size_t i = 0;
+            for (; i + 8 <= key.size(); i += 8) {
+                h = (h ^ readBytes(key.data() + i, 8)) * util::k_hash_p1;
+                h ^= h >> 32;
+            }
+            if (i < key.size()) {
+                h = (h ^ readBytes(key.data() + i, key.size() - i)) * util::k_hash_p1;
+                h ^= h >> 32;
+            }
+            return util::mix::Fmix64::mix(h);
+        }
+        template <typename T>
+            requires(std::is_integral_v<T> || std::is_enum_v<T>)
+        constexpr u64 hashKey(T key, u64 seed) {
+            return util::mix::Fmix64::mix((u64)key ^ seed);
+        }
+    } // namespace frozen_detail
+
+    template <typename TKey, typename TVal>
+    struct FrozenEntry {
+        TKey key{};
+        TVal value{};
+    };
+
+    /*
+     * Immutable hash map built at compile time, lives in read-only data and needs no
+     * runtime initialization. Keys: std::string_view (string literals), integers, enums.
+     *
+     * Perfect hashing PTHash-style: key hash picks a bucket (~2 keys per bucket), every
+     * bucket stores a displacement found by trying pilots, largest buckets first, until all
+     * of its keys land in free slots. find() is one hash, one displacement read, one slot
+     * read and one key compare; there are no probes and no empty-slot checks: empty slots
+     * hold a copy of a key whose own slot is elsewhere, so it never compares equal there.
+     *
+     * Duplicate keys and failed seed search are compile errors when built in constexpr:
+     *
+     *     constexpr auto k_commands = makeFrozenMap<std::string_view, ECommand>({
+     *         {"quit", ECommand::Quit},
+     *         {"help", ECommand::Help},
+     *     });
+     *     static_assert(*k_commands.find("help") == ECommand::Help);
+     */
+    template <typename TKey, typename TVal, u32 k_num>
+    class FrozenMap {
+        static_assert(k_num > 0, "FrozenMap needs at least one entry");
+
+    public:
+        using Entry = FrozenEntry<TKey, TVal>;
+
+        static constexpr u32 k_num_buckets = (k_num + 1) / 2;
+        // load factor <= 0.8
+        static constexpr u32 k_num_slots = std::bit_ceil(k_num + (k_num + 3) / 4);
+        static constexpr u32 k_slot_bits = (u32)std::countr_zero(k_num_slots);
+        static constexpr u32 k_max_seeds = 64;
+        static constexpr u32 k_max_pilots = 1u << 14;
+
+        constexpr explicit FrozenMap(const Entry (&entries)[k_num]) {
+            for (u32 attempt = 0; attempt < k_max_seeds; ++attempt) {
+                if (tryBuild(entries, rng::Splitmix64::stateless(k_num, attempt)))
+                    return;
+            }
+            frozen_detail::frozenMapSeedSearchFailed();
+        }
+
+        constexpr const TVal* find(const TKey& key) const {
+            const u64 h = frozen_detail::hashKey(key, seed);
+            const Entry& slot = slots[slotOf(h, displacements[bucketOf(h)])];
+            return slot.key == key ? &slot.value : nullptr;
+        }
+        constexpr bool contains(const TKey& key) const { return find(key) != nullptr; }
+        constexpr TVal valueOr(const TKey& key, const TVal& fallback) const {
+            const TVal* v = find(key);
+            return v != nullptr ? *v : fallback;
+        }
+
+        constexpr auto size() const -> u32 { return k_num; }
+
+    private:
+        static constexpr u32 bucketOf(u64 h) {
+            return (u32)(((h >> 32) * k_num_buckets) >> 32);
+        }
+        static constexpr u32 slotOf(u64 h, u64 displacement) {
+            if constexpr (k_slot_bits == 0)
+                return 0;
+            else
+                return (u32)(((h ^ displacement) * util::k_hash_p3) >> (64 - k_slot_bits));
+        }
+
+        constexpr bool tryBuild(const Entry (&entries)[k_num], u64 in_seed) {
+            seed = in_seed;
+            displacements = {};
+
+            // keys grouped by bucket: bucket b owns order[offsets[b] .. offsets[b + 1])
+            std::array<u64, k_num> hashes{};
+            std::array<u32, k_num_buckets + 1> offsets{};
+            for (u32 i = 0; i < k_num; ++i) {
+                hashes[i] = frozen_detail::hashKey(entries[i].key, seed);
+                offsets[bucketOf(hashes[i]) + 1]++;
+            }
+            u32 max_size = 0;
+            for (u32 b = 0; b < k_num_buckets; ++b) {
+                max_size = offsets[b + 1] > max_size ? offsets[b + 1] : max_size;
+                offsets[b + 1] += offsets[b];
+            }
+            std::array<u32, k_num> order{};
+            std::array<u32, k_num_buckets + 1> cursor = offsets;
+            for (u32 i = 0; i < k_num; ++i)
+                order[cursor[bucketOf(hashes[i])]++] = i;
+
+            std::array<bool, k_num_slots> taken{};
+            std::array<u32, k_num> placed{};
+            for (u32 size = max_size; size > 0; --size) {
+                for (u32 b = 0; b < k_num_buckets; ++b) {
+                    const u32 first = offsets[b];
+                    if (offsets[b + 1] - first != size)
+                        continue;
+
+                    // equal hashes land in the same slot whatever the displacement is
+                    for (u32 i = first; i < first + size; ++i) {
+                        for (u32 j = first; j < i; ++j) {
+                            if (hashes[order[i]] != hashes[order[j]])
+                                continue;
+                            if (entries[order[i]].key == entries[order[j]].key)
+                                frozen_detail::duplicateKeyInFrozenMap();
+                            return false;
+                        }
+                    }
+
+                    bool found = false;
+                    for (u32 pilot = 0; pilot < k_max_pilots && !found; ++pilot) {
+                        const u64 displacement = rng::Splitmix64::stateless(seed, pilot);
+                        found = true;
+                        for (u32 i = 0; i < size && found; ++i) {
+                            const u32 s = slotOf(hashes[order[first + i]], displacement);
+                            found = !taken[s];
+                            for (u32 j = 0; j < i && found; ++j)
+                                found = placed[j] != s;
+                            placed[i] = s;
+                        }
+                        if (found) {
+                            displacements[b] = displacement;
+                            for (u32 i = 0; i < size; ++i)
+                                taken[placed[i]] = true;
+                        }
+                    }
+                    if (!found)
+                        return false;
+                }
+            }
+
+            for (u32 i = 0; i < k_num; ++i)
+                slots[slotOf(hashes[i], displacements[bucketOf(hashes[i])])] = entries[i];
+            for (u32 s = 0; s < k_num_slots; ++s) {
+                if (!taken[s])
+                    slots[s] = entries[0];
+            }
+            return true;
+        }
+
+        u64 seed = 0;
+        std::array<u64, k_num_buckets> displacements{};
+        std::array<Entry, k_num_slots> slots{};
+    };
+
+    template <typename TKey, typename TVal, size_t k_num>
+    constexpr auto makeFrozenMap(const FrozenEntry<TKey, TVal> (&entries)[k_num]) {
+        return FrozenMap<TKey, TVal, (u32)k_num>(entries);
+    }
+} // namespace vex
@@ -0,0 +1,71 @@
+#include "MirroredRing.h"
+
+#include <stdlib.h>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace vex {
+    u64 MirroredMemory::pageSize() {
+#if defined(__linux__)
+        static const u64 page = (u64)sysconf(_SC_PAGESIZE);
+        return page;
+#else
+        return 4096;
+#endif
+    }
+
+    MirroredMemory MirroredMemory::create(u64 min_size) {
+        u64 size = pageSize();
+        while (size < min_size)
+            size *= 2;
+
+        MirroredMemory mem;
+#if defined(__linux__)
+        const int fd = memfd_create("vex_mirrored_ring", MFD_CLOEXEC);
+        if (fd >= 0) {
+            // reserve 2 * size of address space, then map the same file over both halves
+            void* region = MAP_FAILED;
+            if (ftruncate(fd, (off_t)size) == 0)
+                region = mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (region != MAP_FAILED) {
+                u8* base = (u8*)region;
+                void* lo = mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                void* hi =
+                    mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                if (lo == base && hi == base + size) {
+                    mem.base = base;
+                    mem.size = size;
+                    mem.is_mirrored = true;
+                } else {
+                    munmap(region, size * 2);
+                }
+            }
+            close(fd); // mappings keep the file alive
+        }
+        if (mem.isValid())
+            return mem;
+#endif
+        // no double mapping available: 2 halves that owner keeps in sync
+        mem.base = (u8*)::malloc(size * 2);
+        mem.size = mem.base ? size : 0;
+        mem.is_mirrored = false;
+        return mem;
+    }
+
+    void MirroredMemory::release(MirroredMemory& mem) {
+        if (!mem.base)
+            return;
+#if defined(__linux__)
+        if (mem.is_mirrored)
+            munmap(mem.base, mem.size * 2);
+        else
+            ::free(mem.base);
+#else
+        ::free(mem.base);
+#endif
+        mem = {};
+    }
+} // namespace vex
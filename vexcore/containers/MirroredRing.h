@@ -0,0 +1,148 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/SOABuffer.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <utility>
+
+namespace vex {
+    /*
+     * 'size' bytes of memory that are visible twice back to back: base[i] and base[i + size]
+     * are the same byte. On Linux it is one memfd mapped twice, elsewhere it falls back to a
+     * plain 2 * size allocation (is_mirrored == false) and the owner has to duplicate writes.
+     */
+    struct MirroredMemory {
+        u8* base = nullptr;
+        u64 size = 0;
+        bool is_mirrored = false;
+
+        FORCE_INLINE auto isValid() const -> bool { return base != nullptr; }
+
+        // size is rounded up to power of 2 that is at least one page
+        static MirroredMemory create(u64 min_size);
+        static void release(MirroredMemory& mem);
+        static u64 pageSize();
+    };
+
+    /*
+     * Byte (or small POD) FIFO ring where any read or write of up to capacity() elements is
+     * contiguous, so messages can be decoded in place without reassembling the wrapped part.
+     * Not thread-safe, same as StaticRing.
+     *
+     * Positions are free running u64, offset into storage is (pos & mask). Capacity is fixed at
+     * construction and is a power of 2 (rounded up to at least a page of bytes).
+     */
+    template <typename T = u8>
+    class MirroredRing {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+            "MirroredRing is only for trivial types");
+        static_assert((sizeof(T) & (sizeof(T) - 1)) == 0, "sizeof(T) must be a power of 2");
+
+    public:
+        using ValueType = T;
+
+        MirroredRing() = default;
+        explicit MirroredRing(i32 min_capacity) {
+            mem = MirroredMemory::create((u64)(min_capacity > 1 ? min_capacity : 1) * sizeof(T));
+            checkLethal(mem.isValid(), "failed to map mirrored memory");
+            mask = mem.size / sizeof(T) - 1;
+        }
+        MirroredRing(const MirroredRing&) = delete;
+        MirroredRing& operator=(const MirroredRing&) = delete;
+        MirroredRing(MirroredRing&& other) noexcept { *this = std::move(other); }
+        MirroredRing& operator=(MirroredRing&& other) noexcept {
+            if (this != &other) {
+                MirroredMemory::release(mem);
+                mem = std::exchange(other.mem, {});
+                mask = std::exchange(other.mask, 0);
+                read_pos = std::exchange(other.read_pos, 0);
+                write_pos = std::exchange(other.write_pos, 0);
+            }
+            return *this;
+        }
+        ~MirroredRing() { MirroredMemory::release(mem); }
+
+        FORCE_INLINE auto capacity() const -> i32 { return mem.isValid() ? (i32)(mask + 1) : 0; }
+        FORCE_INLINE auto size() const -> i32 { return (i32)(write_pos - read_pos); }
+        FORCE_INLINE auto isEmpty() const -> bool { return write_pos == read_pos; }
+        FORCE_INLINE auto isFull() const -> bool { return size() == capacity(); }
+        FORCE_INLINE auto isMirrored() const -> bool { return mem.is_mirrored; }
+
+        // ---------------------------------------------------------------- write
+        FORCE_INLINE bool push(const T& val) { return pushN(&val, 1) == 1; }
+        // copies as many as fits, returns number of pushed elements
+        i32 pushN(const T* src, i32 num) {
+            const RawBuffer<T> dst = prepareWrite(num);
+            if (dst.size() > 0)
+                memcpy(dst.first, src, dst.size() * sizeof(T));
+            commitWrite(dst.size());
+            return dst.size();
+        }
+        FORCE_INLINE i32 pushN(ROSpan<T> src) { return pushN(src.data, src.size()); }
+
+        // up to 'num' free contiguous slots after the newest element, contents are undefined
+        FORCE_INLINE auto prepareWrite(i32 num) -> RawBuffer<T> {
+            const i32 free_slots = capacity() - size();
+            num = num < free_slots ? num : free_slots;
+            return RawBuffer<T>(data() + (write_pos & mask), (u32)(num > 0 ? num : 0));
+        }
+        FORCE_INLINE void commitWrite(i32 num) {
+            checkAlways(num >= 0 && num <= capacity() - size(), "commit is out of bounds");
+            if (!mem.is_mirrored)
+                mirrorWrite((u32)(write_pos & mask), (u32)num);
+            write_pos += (u64)num;
+        }
+
+        // ---------------------------------------------------------------- read
+        // all stored elements oldest first, always one contiguous span
+        FORCE_INLINE auto peek() const -> ROSpan<T> {
+            return ROSpan<T>{data() + (read_pos & mask), size()};
+        }
+        FORCE_INLINE auto peek(i32 max_num) const -> ROSpan<T> {
+            const i32 num = size();
+            return ROSpan<T>{data() + (read_pos & mask), max_num < num ? max_num : num};
+        }
+        FORCE_INLINE void consume(i32 num) {
+            checkAlways(num >= 0 && num <= size(), "consume is out of bounds");
+            read_pos += (u64)num;
+        }
+        // copies out up to max_num oldest elements, returns number of popped elements
+        i32 popN(T* dst, i32 max_num) {
+            const ROSpan<T> src = peek(max_num);
+            if (src.size() > 0)
+                memcpy(dst, src.data, src.size() * sizeof(T));
+            consume(src.size());
+            return src.size();
+        }
+
+        void clear() {
+            read_pos = 0;
+            write_pos = 0;
+        }
+
+    private:
+        FORCE_INLINE T* data() const { return (T*)mem.base; }
+
+        // fallback path: keep both halves in sync, written range may already spill into 2nd
+        void mirrorWrite(u32 at, u32 num) {
+            const u32 cap = (u32)(mask + 1);
+            const u32 low_num = at + num <= cap ? num : cap - at;
+            T* base = data();
+            if (low_num > 0)
+                memcpy(base + cap + at, base + at, low_num * sizeof(T));
+            if (num > low_num)
+                memcpy(base, base + cap, (num - low_num) * sizeof(T));
+        }
+
+        MirroredMemory mem;
+        u64 mask = 0;
+        u64 read_pos = 0;
+        u64 write_pos = 0;
+    };
+} // namespace vex
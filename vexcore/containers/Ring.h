@@ -5,11 +5,28 @@
  */
 
 #include <vexcore/containers/Union.h>
+#include <vexcore/memory/Memory.h>
 #include <vexcore/utils/CoreTemplates.h>
 #include <vexcore/utils/VUtilsBase.h>
 
 namespace vex
 {
+    /*
+        Contiguous view of ring contents, wrapped part (if any) is in 'second'.
+        Order of elements is 'first' then 'second'.
+    */
+    template <typename T>
+    struct SplitSpan
+    {
+        T* first = nullptr;
+        i32 first_len = 0;
+        T* second = nullptr;
+        i32 second_len = 0;
+
+        FORCE_INLINE auto size() const -> i32 { return first_len + second_len; }
+        FORCE_INLINE auto isEmpty() const -> bool { return 0 == size(); }
+    };
+
     /* 
     * 
         Simple Static Ring Buffer, meant mainly for PODs.
@@ -243,6 +260,55 @@ namespace vex
 
         const T* rawDataUnsafe() const { return data_typed; }
 
+        /*
+            Batch I/O directly in ring storage (fill_forward and trivial types only).
+            prepareWrite returns up to 'num' free slots after the newest element, contents are
+            uninitialized, commitWrite publishes first 'num' of them (in span order).
+            peekRead returns all elements oldest first, consumeRead drops 'num' oldest ones.
+        */
+        inline auto prepareWrite(i32 num) -> SplitSpan<T>
+        {
+            static_assert(fill_forward, "span API requires fill_forward ring");
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                "span API is only for trivial types");
+            const i32 free_slots = k_capacity - num_elements;
+            num = num < free_slots ? num : free_slots;
+            if (num <= 0)
+                return {};
+            return splitAt(growIndex(first_ind), num);
+        }
+        inline void commitWrite(i32 num)
+        {
+            checkAlways(num >= 0 && num <= k_capacity - num_elements, "commit is out of bounds");
+            if (num <= 0)
+                return;
+            num_elements += num;
+            first_ind = (first_ind + num) % k_capacity;
+        }
+        inline auto peekRead() -> SplitSpan<T>
+        {
+            static_assert(fill_forward, "span API requires fill_forward ring");
+            if (num_elements <= 0)
+                return {};
+            return splitAt(toRawIndex(num_elements - 1), num_elements);
+        }
+        inline auto peekRead() const -> SplitSpan<const T>
+        {
+            static_assert(fill_forward, "span API requires fill_forward ring");
+            if (num_elements <= 0)
+                return {};
+            const SplitSpan<T> s = const_cast<StaticRing*>(this)->splitAt(
+                toRawIndex(num_elements - 1), num_elements);
+            return {s.first, s.first_len, s.second, s.second_len};
+        }
+        inline void consumeRead(i32 num)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "span API is for trivial types");
+            checkAlways(num >= 0 && num <= num_elements, "consume is out of bounds");
+            // oldest element is derived from first_ind and size, so dropping is just a count
+            num_elements -= num;
+        }
+
         // last added element considered 'first'
         // do not use this type directly, it is meant for ranged for exclusively
         template <bool Const>
@@ -363,10 +429,288 @@ namespace vex
         inline T* item(i32 i) { return &data_typed[i]; }
         inline const T* item(i32 i) const { return &data_typed[i]; }
 
+        // 'num' elements starting at raw index 'start', going forward and wrapping once
+        inline auto splitAt(i32 start, i32 num) -> SplitSpan<T>
+        {
+            const i32 first_len = num < k_capacity - start ? num : k_capacity - start;
+            return {data_typed + start, first_len, data_typed, num - first_len};
+        }
+
         i32 num_elements = 0;
         // index of a 'first' element in ring/stack (meaning last added)
         // initialized with invalid index, that would be valid after first 'put'
         i32 first_ind = fill_forward ? -1 : k_capacity;
     };
 
+    /*
+        Growable double-ended queue, storage taken from Allocator handle.
+        In contrast to StaticRing it has plain deque semantics: front is the oldest element
+        when only pushBack is used, at(0) is front.
+
+        Capacity is always a power of 2 so wrap is a mask. On growth contents are unwrapped,
+        element at 'head' lands at index 0 of new storage.
+    */
+    template <class T>
+    class Ring
+    {
+    public:
+        using ValueType = T;
+        static constexpr i32 k_min_capacity = 8;
+
+        Ring() = default;
+        explicit Ring(Allocator al) : allocator(al) {}
+        Ring(Allocator al, i32 in_cap) : allocator(al) { reserve(in_cap); }
+
+        Ring(const Ring& other) : allocator(other.allocator)
+        {
+            reserve(other.len);
+            for (i32 i = 0; i < other.len; ++i)
+                new (first + i) T(other.at(i));
+            len = other.len;
+        }
+        Ring& operator=(const Ring& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.len);
+                for (i32 i = 0; i < other.len; ++i)
+                    new (first + i) T(other.at(i));
+                head = 0;
+                len = other.len;
+            }
+            return *this;
+        }
+        Ring(Ring&& other) noexcept { *this = std::move(other); }
+        Ring& operator=(Ring&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                allocator = other.allocator;
+                first = std::exchange(other.first, nullptr);
+                head = std::exchange(other.head, 0);
+                len = std::exchange(other.len, 0);
+                cap = std::exchange(other.cap, 0);
+            }
+            return *this;
+        }
+        ~Ring() { release(); }
+
+        FORCE_INLINE auto size() const -> i32 { return len; }
+        FORCE_INLINE auto capacity() const -> i32 { return cap; }
+        FORCE_INLINE auto isEmpty() const -> bool { return 0 == len; }
+
+        FORCE_INLINE auto at(i32 i) -> T&
+        {
+            checkLethal((i >= 0) && (i < len), "out of bounds");
+            return first[wrap(head + i)];
+        }
+        FORCE_INLINE auto at(i32 i) const -> const T&
+        {
+            checkLethal((i >= 0) && (i < len), "out of bounds");
+            return first[wrap(head + i)];
+        }
+        FORCE_INLINE auto operator[](i32 i) -> T& { return at(i); }
+        FORCE_INLINE auto operator[](i32 i) const -> const T& { return at(i); }
+
+        // nullptr if empty
+        FORCE_INLINE auto front() -> T* { return len > 0 ? first + head : nullptr; }
+        FORCE_INLINE auto back() -> T* { return len > 0 ? first + wrap(head + len - 1) : nullptr; }
+
+        template <typename... TArgs>
+        inline T& emplaceBack(TArgs&&... args)
+        {
+            if (len == cap)
+                grow();
+            T* item = first + wrap(head + len);
+            new (item) T(std::forward<TArgs>(args)...);
+            len++;
+            return *item;
+        }
+        template <typename... TArgs>
+        inline T& emplaceFront(TArgs&&... args)
+        {
+            if (len == cap)
+                grow();
+            head = wrap(head - 1 + cap);
+            T* item = first + head;
+            new (item) T(std::forward<TArgs>(args)...);
+            len++;
+            return *item;
+        }
+        template <typename TFwd>
+        FORCE_INLINE T& pushBack(TFwd&& val)
+        {
+            return emplaceBack(std::forward<TFwd>(val));
+        }
+        template <typename TFwd>
+        FORCE_INLINE T& pushFront(TFwd&& val)
+        {
+            return emplaceFront(std::forward<TFwd>(val));
+        }
+
+        [[nodiscard]] inline auto popFront() -> vex::Option<T>
+        {
+            if (len <= 0)
+                return {};
+            T* item = first + head;
+            Option<T> out_val{std::move(*item)};
+            item->~T();
+            head = wrap(head + 1);
+            len--;
+            return out_val;
+        }
+        [[nodiscard]] inline auto popBack() -> vex::Option<T>
+        {
+            if (len <= 0)
+                return {};
+            T* item = first + wrap(head + len - 1);
+            Option<T> out_val{std::move(*item)};
+            item->~T();
+            len--;
+            return out_val;
+        }
+        [[nodiscard]] inline auto popFrontUnchecked() -> T
+        {
+            checkAlways_(len > 0);
+            T* item = first + head;
+            T tmp = std::move(*item);
+            item->~T();
+            head = wrap(head + 1);
+            len--;
+            return tmp;
+        }
+        [[nodiscard]] inline auto popBackUnchecked() -> T
+        {
+            checkAlways_(len > 0);
+            T* item = first + wrap(head + len - 1);
+            T tmp = std::move(*item);
+            item->~T();
+            len--;
+            return tmp;
+        }
+        // removes up to num elements from front
+        inline void discardFront(i32 num)
+        {
+            num = num < len ? num : len;
+            for (i32 i = 0; i < num; ++i)
+            {
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                    first[head].~T();
+                head = wrap(head + 1);
+            }
+            len -= num > 0 ? num : 0;
+        }
+
+        inline void clear()
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (i32 i = 0; i < len; ++i)
+                    first[wrap(head + i)].~T();
+            }
+            head = 0;
+            len = 0;
+        }
+
+        // rounds capacity up to power of 2
+        void reserve(i32 num)
+        {
+            if (num <= cap)
+                return;
+            i32 new_cap = cap > k_min_capacity ? cap : k_min_capacity;
+            while (new_cap < num)
+                new_cap *= 2;
+
+            T* new_first = vexAllocTyped<T>(allocator, (u64)new_cap, alignof(T));
+            checkLethal(new_first, "failure of allocator");
+
+            const SplitSpan<T> spans = asSpans();
+            relocate(new_first, spans.first, spans.first_len);
+            relocate(new_first + spans.first_len, spans.second, spans.second_len);
+
+            vexFree(allocator, first);
+            first = new_first;
+            head = 0;
+            cap = new_cap;
+        }
+
+        // elements in front-to-back order, second part is empty if contents do not wrap
+        FORCE_INLINE auto asSpans() -> SplitSpan<T>
+        {
+            const i32 first_len = len < cap - head ? len : cap - head;
+            return {first + head, first_len, first, len - first_len};
+        }
+        FORCE_INLINE auto asSpans() const -> SplitSpan<const T>
+        {
+            const i32 first_len = len < cap - head ? len : cap - head;
+            return {first + head, first_len, first, len - first_len};
+        }
+
+        // front to back, meant for ranged for exclusively
+        template <bool Const>
+        struct Iterator
+        {
+            using RingType = typename AddConst<Ring<T>, Const>::type;
+            friend auto operator==(Iterator lhs, impl::vxSentinel rhs) { return lhs.isDone(); }
+            friend auto operator==(impl::vxSentinel lhs, Iterator rhs) { return rhs == lhs; }
+            friend auto operator!=(Iterator lhs, impl::vxSentinel rhs) { return !(lhs == rhs); }
+            friend auto operator!=(impl::vxSentinel lhs, Iterator rhs) { return !(lhs == rhs); }
+            bool isDone() const { return offset >= ring.len; }
+
+            inline decltype(auto) operator*() const { return ring.at(offset); }
+            inline decltype(auto) operator++()
+            {
+                offset += 1;
+                return *this;
+            }
+
+            RingType& ring;
+            i32 offset = 0;
+
+            Iterator(const Iterator&) = default;
+            Iterator(RingType& in_ring) : ring(in_ring) {}
+        };
+        auto begin() noexcept { return Iterator<false>{*this}; };
+        auto end() const noexcept { return k_seq_end; };
+        auto begin() const noexcept { return Iterator<true>{*this}; };
+
+    private:
+        FORCE_INLINE auto wrap(i32 i) const -> i32 { return i & (cap - 1); }
+
+        void grow() { reserve(cap > 0 ? cap * 2 : k_min_capacity); }
+
+        static void relocate(T* dst, T* src, i32 num)
+        {
+            if (num <= 0)
+                return;
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                memcpy(dst, src, num * sizeof(T));
+            }
+            else
+            {
+                for (i32 i = 0; i < num; ++i)
+                {
+                    new (dst + i) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+        }
+
+        void release()
+        {
+            clear();
+            vexFree(allocator, first);
+            first = nullptr;
+            cap = 0;
+        }
+
+        Allocator allocator;
+        T* first = nullptr; // storage
+        i32 head = 0;       // storage index of front element
+        i32 len = 0;
+        i32 cap = 0;
+    };
 } // namespace vex
@@ -45,17 +45,23 @@ namespace vex
 
         void copyTo(const RawBuffer<T>& other)
         {
-            for (u32 i = 0u; i < capacity && i < other.capacity; i++)
+            const u32 num = capacity < other.capacity ? capacity : other.capacity;
+            if constexpr (std::is_trivially_copyable_v<T>)
             {
-                other[i] = (*this)[i];
+                if (num > 0)
+                    memcpy(other.first, first, num * sizeof(T));
+            }
+            else
+            {
+                for (u32 i = 0u; i < num; i++)
+                {
+                    other[i] = (*this)[i];
+                }
             }
         }
         void copyTo(const RawBuffer<T>& other, const T& fillVal)
         {
-            for (auto i = 0u; i < capacity && i < other.capacity; i++)
-            {
-                other[i] = (*this)[i];
-            }
+            copyTo(other);
 
             for (u32 i = (u32)this->capacity; i < other.capacity; i++)
             {
@@ -97,7 +103,7 @@ namespace vex
         template <size_t ARRAY_ID, typename T>
         inline T& get(i32 index) const
         {
-            return *(std::get<ARRAY_ID>(blocks).template range_start<T>(memory_region) + index);
+            return *(std::get<ARRAY_ID>(blocks).template start<T>(memory_region) + index);
         }
 
         inline u32 size() const noexcept { return capacity; }
@@ -0,0 +1,288 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <algorithm>
+
+namespace vex {
+    /*
+     * Handle that packs slot index and generation into single integer.
+     * Generation 0 is never handed out, so zeroed handle is always invalid.
+     * SlotHandle32 - up to ~1M live slots, 4095 reuses of a slot before it is retired.
+     * SlotHandle64 - 32 bit index, 32 bit generation.
+     */
+    template <typename TStorage, u32 k_index_bits>
+    struct SlotHandle {
+        static_assert(std::is_unsigned_v<TStorage>);
+        static_assert(k_index_bits > 0 && k_index_bits < sizeof(TStorage) * 8);
+
+        static constexpr u32 k_gen_bits = sizeof(TStorage) * 8 - k_index_bits;
+        static constexpr TStorage k_index_mask = (TStorage(1) << k_index_bits) - 1;
+        static constexpr TStorage k_gen_mask = TStorage(~TStorage(0)) >> k_index_bits;
+        static constexpr u32 k_max_index = (u32)std::min<u64>(k_index_mask, 0xffffffffu);
+        static constexpr u32 k_max_gen = (u32)std::min<u64>(k_gen_mask, 0xffffffffu);
+
+        TStorage bits = 0;
+
+        static constexpr SlotHandle make(u32 index, u32 gen) {
+            return {(TStorage)((TStorage(gen) << k_index_bits) | (index & k_index_mask))};
+        }
+
+        FORCE_INLINE constexpr auto index() const -> u32 { return (u32)(bits & k_index_mask); }
+        FORCE_INLINE constexpr auto generation() const -> u32 {
+            return (u32)(bits >> k_index_bits);
+        }
+        FORCE_INLINE constexpr auto isValid() const -> bool { return generation() != 0; }
+
+        friend constexpr bool operator==(SlotHandle a, SlotHandle b) { return a.bits == b.bits; }
+        friend constexpr bool operator!=(SlotHandle a, SlotHandle b) { return a.bits != b.bits; }
+    };
+
+    using SlotHandle32 = SlotHandle<u32, 20>;
+    using SlotHandle64 = SlotHandle<u64, 32>;
+
+    /*
+     * Generational slot map: O(1) insert/erase/lookup by handle without hashing.
+     * Values are stored densely (erase swaps last element into the hole), so iteration is
+     * a plain walk over contiguous array, same as with Buffer. Indirection goes through
+     * 'slots' array: handle.index -> slot -> dense index.
+     *
+     * NOTE: erase CHANGES order of values, pointers to values are invalidated by insert/erase,
+     * handles stay valid until their value is erased.
+     */
+    template <typename ValType, typename THandle = SlotHandle32>
+    class SlotMap {
+        static constexpr u32 k_none = 0xffffffffu;
+
+        struct Slot {
+            // dense index when slot is alive, next free slot otherwise
+            u32 dense_or_next = k_none;
+            u32 generation = 1;
+        };
+
+    public:
+        using Handle = THandle;
+        using ValueType = ValType;
+
+        SlotMap() = default;
+        explicit SlotMap(Allocator al) : allocator(al) {}
+        SlotMap(Allocator al, i32 in_cap) : allocator(al) { reserve(in_cap); }
+
+        SlotMap(const SlotMap&) = delete;
+        SlotMap& operator=(const SlotMap&) = delete;
+        SlotMap(SlotMap&& other) noexcept { *this = std::move(other); }
+        SlotMap& operator=(SlotMap&& other) noexcept {
+            if (this != &other) {
+                release();
+                allocator = other.allocator;
+                values = std::exchange(other.values, nullptr);
+                dense_to_slot = std::exchange(other.dense_to_slot, nullptr);
+                slots = std::exchange(other.slots, nullptr);
+                len = std::exchange(other.len, 0);
+                cap = std::exchange(other.cap, 0);
+                slot_count = std::exchange(other.slot_count, 0);
+                slot_cap = std::exchange(other.slot_cap, 0);
+                free_head = std::exchange(other.free_head, k_none);
+            }
+            return *this;
+        }
+        ~SlotMap() { release(); }
+
+        FORCE_INLINE auto size() const -> i32 { return (i32)len; }
+        FORCE_INLINE auto capacity() const -> i32 { return (i32)cap; }
+        FORCE_INLINE auto isEmpty() const -> bool { return len == 0; }
+
+        FORCE_INLINE auto data() -> ValType* { return values; }
+        FORCE_INLINE auto data() const -> const ValType* { return values; }
+        FORCE_INLINE auto begin() -> ValType* { return values; }
+        FORCE_INLINE auto end() -> ValType* { return values + len; }
+        FORCE_INLINE auto begin() const -> const ValType* { return values; }
+        FORCE_INLINE auto end() const -> const ValType* { return values + len; }
+        FORCE_INLINE ROSpan<ValType> constSpan() const { return {values, (i32)len}; }
+
+        template <typename... TArgs>
+        Handle emplace(TArgs&&... args) {
+            if (len == cap)
+                grow();
+
+            u32 slot_idx = acquireSlot();
+            Slot& slot = slots[slot_idx];
+            slot.dense_or_next = len;
+
+            new (values + len) ValType(std::forward<TArgs>(args)...);
+            dense_to_slot[len] = slot_idx;
+            len++;
+
+            return Handle::make(slot_idx, slot.generation);
+        }
+        template <typename InValType>
+        FORCE_INLINE Handle insert(InValType&& in_val) {
+            return emplace(std::forward<InValType>(in_val));
+        }
+
+        FORCE_INLINE auto contains(Handle h) const -> bool { return denseIndexOf(h) != k_none; }
+
+        FORCE_INLINE auto find(Handle h) -> ValType* {
+            u32 d = denseIndexOf(h);
+            return d != k_none ? values + d : nullptr;
+        }
+        FORCE_INLINE auto find(Handle h) const -> const ValType* {
+            u32 d = denseIndexOf(h);
+            return d != k_none ? values + d : nullptr;
+        }
+        FORCE_INLINE auto operator[](Handle h) -> ValType& {
+            u32 d = denseIndexOf(h);
+            checkLethal(d != k_none, "stale or invalid slot handle");
+            return values[d];
+        }
+        FORCE_INLINE auto operator[](Handle h) const -> const ValType& {
+            u32 d = denseIndexOf(h);
+            checkLethal(d != k_none, "stale or invalid slot handle");
+            return values[d];
+        }
+
+        // handle of the value stored at dense index i (for iteration with ids)
+        FORCE_INLINE auto handleAt(i32 i) const -> Handle {
+            checkLethal((i >= 0) && ((u32)i < len), "out of bounds");
+            const u32 slot_idx = dense_to_slot[i];
+            return Handle::make(slot_idx, slots[slot_idx].generation);
+        }
+
+        bool erase(Handle h) {
+            const u32 d = denseIndexOf(h);
+            if (d == k_none)
+                return false;
+
+            const u32 last = len - 1;
+            if (d != last) {
+                values[d] = std::move(values[last]);
+                dense_to_slot[d] = dense_to_slot[last];
+                slots[dense_to_slot[d]].dense_or_next = d;
+            }
+            values[last].~ValType();
+            len--;
+
+            releaseSlot(h.index());
+            return true;
+        }
+
+        void clear() {
+            for (u32 i = 0; i < len; ++i) {
+                if constexpr (!std::is_trivially_destructible_v<ValType>)
+                    values[i].~ValType();
+                releaseSlot(dense_to_slot[i]);
+            }
+            len = 0;
+        }
+
+        void reserve(i32 num) {
+            if (num <= (i32)cap)
+                return;
+
+            auto new_values = vexAllocTyped<ValType>(allocator, num, alignof(ValType));
+            auto new_dense = vexAllocTyped<u32>(allocator, num);
+            checkLethal(new_values && new_dense, "failure of allocator");
+
+            if constexpr (std::is_trivially_copyable_v<ValType>) {
+                if (len > 0)
+                    memcpy(new_values, values, len * sizeof(ValType));
+            } else {
+                for (u32 i = 0; i < len; ++i) {
+                    new (new_values + i) ValType(std::move(values[i]));
+                    values[i].~ValType();
+                }
+            }
+            if (len > 0)
+                memcpy(new_dense, dense_to_slot, len * sizeof(u32));
+
+            vexFree(allocator, values);
+            vexFree(allocator, dense_to_slot);
+            values = new_values;
+            dense_to_slot = new_dense;
+            cap = (u32)num;
+        }
+
+    private:
+        FORCE_INLINE u32 denseIndexOf(Handle h) const {
+            const u32 idx = h.index();
+            if (idx >= slot_count)
+                return k_none;
+            const Slot& slot = slots[idx];
+            return slot.generation == h.generation() ? slot.dense_or_next : k_none;
+        }
+
+        u32 acquireSlot() {
+            if (free_head != k_none) {
+                u32 idx = free_head;
+                free_head = slots[idx].dense_or_next;
+                return idx;
+            }
+
+            checkLethal(slot_count < Handle::k_max_index, "slot map is out of handle indices");
+            if (slot_count == slot_cap) {
+                const u32 new_cap = slot_cap >= 2 ? (slot_cap + slot_cap / 2) : 8;
+                auto new_slots = vexAllocTyped<Slot>(allocator, new_cap);
+                checkLethal(new_slots, "failure of allocator");
+                if (slot_count > 0)
+                    memcpy(new_slots, slots, slot_count * sizeof(Slot));
+                vexFree(allocator, slots);
+                slots = new_slots;
+                slot_cap = new_cap;
+            }
+            new (slots + slot_count) Slot{};
+            return slot_count++;
+        }
+
+        FORCE_INLINE void releaseSlot(u32 idx) {
+            Slot& slot = slots[idx];
+            // slot with exhausted generation is retired for good instead of wrapping around,
+            // otherwise very old handle could alias new value
+            if (slot.generation >= Handle::k_max_gen) {
+                slot.generation = 0;
+                slot.dense_or_next = k_none;
+                return;
+            }
+            slot.generation++;
+            slot.dense_or_next = free_head;
+            free_head = idx;
+        }
+
+        void grow() {
+            // same policy as Buffer: 1.5 growth, 5 elements minimum
+            const i32 grow_cap = cap >= 2 ? (i32)(cap + cap / 2) : 5;
+            reserve(grow_cap);
+        }
+
+        void release() {
+            if constexpr (!std::is_trivially_destructible_v<ValType>) {
+                for (u32 i = 0; i < len; ++i)
+                    values[i].~ValType();
+            }
+            vexFree(allocator, values);
+            vexFree(allocator, dense_to_slot);
+            vexFree(allocator, slots);
+            values = nullptr;
+            dense_to_slot = nullptr;
+            slots = nullptr;
+            len = cap = slot_count = slot_cap = 0;
+            free_head = k_none;
+        }
+
+        Allocator allocator;
+        ValType* values = nullptr;
+        u32* dense_to_slot = nullptr;
+        Slot* slots = nullptr;
+        u32 len = 0;
+        u32 cap = 0;
+        u32 slot_count = 0;
+        u32 slot_cap = 0;
+        u32 free_head = k_none;
+    };
+} // namespace vex
@@ -0,0 +1,224 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/SOABuffer.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <array>
+#include <tuple>
+
+namespace vex {
+    /*
+     * Growable structure-of-arrays vector: one column per type, all columns live in one
+     * allocation taken from Allocator handle. Every column starts at k_column_align boundary
+     * so columns can be fed to vectorized loops directly (see columnSpan/column).
+     * In contrast to SOAUniBuffer it tracks size, grows and destroys elements.
+     */
+    template <typename... Ts>
+    class SoaVec {
+    public:
+        static_assert(sizeof...(Ts) > 0, "empty SoaVec");
+        static constexpr u32 k_column_count = sizeof...(Ts);
+        static constexpr u32 k_column_align = 64;
+
+        template <size_t I>
+        using NthType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        SoaVec() = default;
+        explicit SoaVec(Allocator al) : allocator(al) {}
+        SoaVec(Allocator al, i32 in_cap) : allocator(al) { reserve(in_cap); }
+
+        SoaVec(const SoaVec&) = delete;
+        SoaVec& operator=(const SoaVec&) = delete;
+        SoaVec(SoaVec&& other) noexcept { *this = std::move(other); }
+        SoaVec& operator=(SoaVec&& other) noexcept {
+            if (this != &other) {
+                release();
+                allocator = other.allocator;
+                memory = std::exchange(other.memory, nullptr);
+                columns = std::exchange(other.columns, {});
+                len = std::exchange(other.len, 0);
+                cap = std::exchange(other.cap, 0);
+            }
+            return *this;
+        }
+        ~SoaVec() { release(); }
+
+        FORCE_INLINE auto size() const -> i32 { return len; }
+        FORCE_INLINE auto capacity() const -> i32 { return cap; }
+        FORCE_INLINE auto isEmpty() const -> bool { return len == 0; }
+
+        template <size_t I>
+        FORCE_INLINE auto column() const -> NthType<I>* {
+            return static_cast<NthType<I>*>(columns[I]);
+        }
+        template <size_t I>
+        FORCE_INLINE auto columnSpan() const -> RawBuffer<NthType<I>> {
+            return RawBuffer<NthType<I>>(column<I>(), (u32)len);
+        }
+        template <size_t I>
+        FORCE_INLINE auto constSpan() const -> ROSpan<NthType<I>> {
+            return ROSpan<NthType<I>>{column<I>(), len};
+        }
+
+        template <size_t I>
+        FORCE_INLINE auto get(i32 i) const -> NthType<I>& {
+            checkLethal((i >= 0) && (i < len), "out of bounds");
+            return column<I>()[i];
+        }
+
+        template <typename... TArgs>
+        FORCE_INLINE void add(TArgs&&... vals) {
+            static_assert(sizeof...(TArgs) == k_column_count, "value per column expected");
+            if (cap <= len)
+                grow();
+            constructAt(len, std::forward_as_tuple(std::forward<TArgs>(vals)...),
+                std::index_sequence_for<Ts...>{});
+            len++;
+        }
+        template <typename TTuple>
+        FORCE_INLINE void pushBack(TTuple&& vals) {
+            static_assert(std::tuple_size_v<std::decay_t<TTuple>> == k_column_count,
+                "value per column expected");
+            if (cap <= len)
+                grow();
+            constructAt(len, std::forward<TTuple>(vals), std::index_sequence_for<Ts...>{});
+            len++;
+        }
+
+        // new elements are value-initialized
+        void resize(i32 num) {
+            if (num < 0)
+                num = 0;
+            if (num > len) {
+                reserve(num);
+                for (i32 i = len; i < num; ++i)
+                    defaultAt(i, std::index_sequence_for<Ts...>{});
+            } else {
+                for (i32 i = num; i < len; ++i)
+                    destroyAt(i, std::index_sequence_for<Ts...>{});
+            }
+            len = num;
+        }
+
+        // moves last element into i-th and reduces len by 1, so it CHANGES order
+        void removeSwapAt(i32 i) {
+            checkLethal((i >= 0) && (i < len), "out of bounds");
+            const i32 last = len - 1;
+            if (i != last)
+                moveAt(last, i, std::index_sequence_for<Ts...>{});
+            destroyAt(last, std::index_sequence_for<Ts...>{});
+            len--;
+        }
+
+        void clear() { resize(0); }
+
+        void reserve(i32 num) {
+            if (num <= cap)
+                return;
+
+            // columns are padded, so the whole region is multiple of k_column_align
+            u64 total = 0;
+            for (u32 c = 0; c < k_column_count; ++c)
+                total += columnBytes(c, num);
+
+            // handle may ignore alignment (malloc), so over-allocate and align manually
+            u8* new_memory = vexAlloc(allocator, total + k_column_align, k_column_align);
+            checkLethal(new_memory, "failure of allocator");
+
+            std::array<void*, k_column_count> new_columns{};
+            u8* cur = alignUp(new_memory);
+            for (u32 c = 0; c < k_column_count; ++c) {
+                new_columns[c] = cur;
+                cur += columnBytes(c, num);
+            }
+
+            relocate(new_columns, std::index_sequence_for<Ts...>{});
+
+            vexFree(allocator, memory);
+            memory = new_memory;
+            columns = new_columns;
+            cap = num;
+        }
+
+    private:
+        // u64: a column of a big SoaVec can exceed 4GB
+        static FORCE_INLINE u64 columnBytes(u32 c, i32 num) {
+            constexpr u64 sizes[k_column_count] = {sizeof(Ts)...};
+            const u64 bytes = sizes[c] * (u64)num;
+            return (bytes + k_column_align - 1) / k_column_align * k_column_align;
+        }
+        static FORCE_INLINE u8* alignUp(u8* ptr) {
+            const u64 addr = (u64)ptr;
+            return ptr + ((k_column_align - (addr % k_column_align)) % k_column_align);
+        }
+
+        void grow() {
+            // same as Buffer: 1.5 growth factor, 5 elements minimum
+            const i32 grow_cap = cap >= 2 ? (cap + cap / 2) : 5;
+            reserve(grow_cap);
+        }
+
+        template <typename TTuple, size_t... I>
+        FORCE_INLINE void constructAt(i32 i, TTuple&& vals, std::index_sequence<I...>) {
+            (new (column<I>() + i) NthType<I>(std::get<I>(std::forward<TTuple>(vals))), ...);
+        }
+        template <size_t... I>
+        FORCE_INLINE void defaultAt(i32 i, std::index_sequence<I...>) {
+            (new (column<I>() + i) NthType<I>(), ...);
+        }
+        template <size_t... I>
+        FORCE_INLINE void destroyAt(i32 i, std::index_sequence<I...>) {
+            (destroyOne<NthType<I>>(column<I>() + i), ...);
+        }
+        template <size_t... I>
+        FORCE_INLINE void moveAt(i32 from, i32 to, std::index_sequence<I...>) {
+            ((column<I>()[to] = std::move(column<I>()[from])), ...);
+        }
+        template <typename T>
+        static FORCE_INLINE void destroyOne(T* ptr) {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                ptr->~T();
+        }
+
+        template <size_t... I>
+        void relocate(const std::array<void*, k_column_count>& dst, std::index_sequence<I...>) {
+            (relocateColumn<NthType<I>>(static_cast<NthType<I>*>(dst[I]), column<I>()), ...);
+        }
+        template <typename T>
+        void relocateColumn(T* dst, T* src) {
+            if (len <= 0)
+                return;
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                memcpy(dst, src, len * sizeof(T));
+            } else {
+                for (i32 i = 0; i < len; ++i) {
+                    new (dst + i) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+        }
+
+        void release() {
+            for (i32 i = 0; i < len; ++i)
+                destroyAt(i, std::index_sequence_for<Ts...>{});
+            vexFree(allocator, memory);
+            memory = nullptr;
+            columns = {};
+            len = 0;
+            cap = 0;
+        }
+
+        Allocator allocator;
+        u8* memory = nullptr; // owning, columns point inside of it
+        std::array<void*, k_column_count> columns{};
+        i32 len = 0;
+        i32 cap = 0;
+    };
+} // namespace vex
@@ -0,0 +1,281 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <bit>
+#include <tuple>
+
+namespace vex {
+    /*
+     * Sparse set keyed by integer ids (entities).
+     * 'sparse' is a paged array id -> dense index, pages are allocated lazily so big sparse
+     * id ranges do not cost memory. 'keys' and 'values' are packed arrays of the same length,
+     * remove swaps last element into the hole so they stay packed (order CHANGES).
+     * All of insert/remove/contains are O(1), iteration is a walk over contiguous arrays.
+     */
+    template <typename ValType, typename TKey = u32, i32 k_page_size = 4096>
+    class SparseSet {
+        static_assert(std::is_integral_v<TKey> && std::is_unsigned_v<TKey>, "key must be unsigned");
+        static_assert(k_page_size > 0 && (k_page_size & (k_page_size - 1)) == 0,
+            "page size must be a power of 2");
+
+        static constexpr u32 k_none = 0xffffffffu;
+        static constexpr u32 k_page_shift = std::countr_zero((u32)k_page_size);
+        static constexpr u32 k_page_mask = (u32)k_page_size - 1;
+
+    public:
+        using KeyType = TKey;
+        using ValueType = ValType;
+
+        SparseSet() = default;
+        explicit SparseSet(Allocator al) : allocator(al) {}
+        SparseSet(Allocator al, i32 in_cap) : allocator(al) { reserve(in_cap); }
+
+        SparseSet(const SparseSet&) = delete;
+        SparseSet& operator=(const SparseSet&) = delete;
+        SparseSet(SparseSet&& other) noexcept { *this = std::move(other); }
+        SparseSet& operator=(SparseSet&& other) noexcept {
+            if (this != &other) {
+                release();
+                allocator = other.allocator;
+                pages = std::exchange(other.pages, nullptr);
+                page_count = std::exchange(other.page_count, 0);
+                keys = std::exchange(other.keys, nullptr);
+                values = std::exchange(other.values, nullptr);
+                len = std::exchange(other.len, 0);
+                cap = std::exchange(other.cap, 0);
+            }
+            return *this;
+        }
+        ~SparseSet() { release(); }
+
+        FORCE_INLINE auto size() const -> i32 { return (i32)len; }
+        FORCE_INLINE auto capacity() const -> i32 { return (i32)cap; }
+        FORCE_INLINE auto isEmpty() const -> bool { return len == 0; }
+
+        FORCE_INLINE auto keysData() const -> const TKey* { return keys; }
+        FORCE_INLINE auto data() -> ValType* { return values; }
+        FORCE_INLINE auto data() const -> const ValType* { return values; }
+        FORCE_INLINE ROSpan<TKey> keySpan() const { return {keys, (i32)len}; }
+        FORCE_INLINE ROSpan<ValType> constSpan() const { return {values, (i32)len}; }
+
+        FORCE_INLINE auto begin() -> ValType* { return values; }
+        FORCE_INLINE auto end() -> ValType* { return values + len; }
+        FORCE_INLINE auto begin() const -> const ValType* { return values; }
+        FORCE_INLINE auto end() const -> const ValType* { return values + len; }
+
+        FORCE_INLINE auto keyAt(i32 i) const -> TKey {
+            checkLethal((i >= 0) && ((u32)i < len), "out of bounds");
+            return keys[i];
+        }
+
+        FORCE_INLINE auto contains(TKey key) const -> bool { return denseIndexOf(key) != k_none; }
+
+        FORCE_INLINE auto find(TKey key) -> ValType* {
+            u32 d = denseIndexOf(key);
+            return d != k_none ? values + d : nullptr;
+        }
+        FORCE_INLINE auto find(TKey key) const -> const ValType* {
+            u32 d = denseIndexOf(key);
+            return d != k_none ? values + d : nullptr;
+        }
+        FORCE_INLINE auto operator[](TKey key) -> ValType& {
+            u32 d = denseIndexOf(key);
+            checkLethal(d != k_none, "key is not in the set");
+            return values[d];
+        }
+        FORCE_INLINE auto operator[](TKey key) const -> const ValType& {
+            u32 d = denseIndexOf(key);
+            checkLethal(d != k_none, "key is not in the set");
+            return values[d];
+        }
+
+        // constructs new value or replaces existing one
+        template <typename... TArgs>
+        ValType& emplace(TKey key, TArgs&&... args) {
+            u32* sparse_slot = sparseSlot(key);
+            if (*sparse_slot != k_none) {
+                // built before assignment, args may refer to the stored value
+                ValType& existing = values[*sparse_slot];
+                existing = ValType(std::forward<TArgs>(args)...);
+                return existing;
+            }
+
+            if (len == cap)
+                grow();
+
+            new (values + len) ValType(std::forward<TArgs>(args)...);
+            keys[len] = key;
+            *sparse_slot = len;
+            return values[len++];
+        }
+        template <typename InValType>
+        FORCE_INLINE ValType& insert(TKey key, InValType&& in_val) {
+            return emplace(key, std::forward<InValType>(in_val));
+        }
+
+        bool remove(TKey key) {
+            const u32 d = denseIndexOf(key);
+            if (d == k_none)
+                return false;
+
+            const u32 last = len - 1;
+            if (d != last) {
+                values[d] = std::move(values[last]);
+                keys[d] = keys[last];
+                *sparseSlotUnchecked(keys[d]) = d;
+            }
+            values[last].~ValType();
+            *sparseSlotUnchecked(key) = k_none;
+            len--;
+            return true;
+        }
+
+        void clear() {
+            for (u32 i = 0; i < len; ++i) {
+                if constexpr (!std::is_trivially_destructible_v<ValType>)
+                    values[i].~ValType();
+                *sparseSlotUnchecked(keys[i]) = k_none;
+            }
+            len = 0;
+        }
+
+        void reserve(i32 num) {
+            if (num <= (i32)cap)
+                return;
+
+            auto new_values = vexAllocTyped<ValType>(allocator, num, alignof(ValType));
+            auto new_keys = vexAllocTyped<TKey>(allocator, num);
+            checkLethal(new_values && new_keys, "failure of allocator");
+
+            if constexpr (std::is_trivially_copyable_v<ValType>) {
+                if (len > 0)
+                    memcpy(new_values, values, len * sizeof(ValType));
+            } else {
+                for (u32 i = 0; i < len; ++i) {
+                    new (new_values + i) ValType(std::move(values[i]));
+                    values[i].~ValType();
+                }
+            }
+            if (len > 0)
+                memcpy(new_keys, keys, len * sizeof(TKey));
+
+            vexFree(allocator, values);
+            vexFree(allocator, keys);
+            values = new_values;
+            keys = new_keys;
+            cap = (u32)num;
+        }
+
+    private:
+        FORCE_INLINE u32 denseIndexOf(TKey key) const {
+            const u64 page = (u64)key >> k_page_shift;
+            if (page >= page_count || pages[page] == nullptr)
+                return k_none;
+            return pages[page][(u32)key & k_page_mask];
+        }
+
+        FORCE_INLINE u32* sparseSlotUnchecked(TKey key) {
+            return &pages[(u64)key >> k_page_shift][(u32)key & k_page_mask];
+        }
+
+        u32* sparseSlot(TKey key) {
+            const u64 page = (u64)key >> k_page_shift;
+            if (page >= page_count) {
+                // u64 keys can address more pages than the u32 page table holds
+                const u64 needed = page + 1;
+                checkLethal(needed <= UINT32_MAX, "key is out of sparse set range");
+                const u64 doubled = (u64)page_count * 2;
+                const u32 new_count =
+                    (u32)(needed > doubled ? needed : doubled < UINT32_MAX ? doubled : UINT32_MAX);
+                auto new_pages = vexAllocTyped<u32*>(allocator, new_count);
+                checkLethal(new_pages, "failure of allocator");
+                if (page_count > 0)
+                    memcpy(new_pages, pages, page_count * sizeof(u32*));
+                memset(new_pages + page_count, 0, (new_count - page_count) * sizeof(u32*));
+                vexFree(allocator, pages);
+                pages = new_pages;
+                page_count = new_count;
+            }
+            if (pages[page] == nullptr) {
+                pages[page] = vexAllocTyped<u32>(allocator, k_page_size);
+                checkLethal(pages[page], "failure of allocator");
+                memset(pages[page], 0xff, k_page_size * sizeof(u32));
+            }
+            return &pages[page][(u32)key & k_page_mask];
+        }
+
+        void grow() {
+            const i32 grow_cap = cap >= 2 ? (i32)(cap + cap / 2) : 5;
+            reserve(grow_cap);
+        }
+
+        void release() {
+            if constexpr (!std::is_trivially_destructible_v<ValType>) {
+                for (u32 i = 0; i < len; ++i)
+                    values[i].~ValType();
+            }
+            for (u32 i = 0; i < page_count; ++i)
+                vexFree(allocator, pages[i]);
+            vexFree(allocator, pages);
+            vexFree(allocator, values);
+            vexFree(allocator, keys);
+            pages = nullptr;
+            keys = nullptr;
+            values = nullptr;
+            page_count = len = cap = 0;
+        }
+
+        Allocator allocator;
+        u32** pages = nullptr;
+        u32 page_count = 0;
+        TKey* keys = nullptr;
+        ValType* values = nullptr;
+        u32 len = 0;
+        u32 cap = 0;
+    };
+
+    /*
+     * Calls func(key, TVals&...) for every key that is present in ALL of the sets.
+     * Smallest set drives the iteration, others are only probed with O(1) lookups.
+     * func may remove current key from any of the sets, other structural changes are not allowed.
+     */
+    template <typename TFunc, typename TSet, typename... TSets>
+    void forEachIntersection(TFunc&& func, TSet& first, TSets&... rest) {
+        using TKey = typename TSet::KeyType;
+        static_assert((std::is_same_v<TKey, typename TSets::KeyType> && ...),
+            "all sets must share key type");
+
+        const TKey* driver_keys = first.keysData();
+        i32 driver_len = first.size();
+        (
+            [&](auto& set) {
+                if (set.size() < driver_len) {
+                    driver_keys = set.keysData();
+                    driver_len = set.size();
+                }
+            }(rest),
+            ...);
+
+        // backwards, so swap-remove of the current key does not skip anything
+        for (i32 i = driver_len - 1; i >= 0; --i) {
+            const TKey key = driver_keys[i];
+            auto* first_val = first.find(key);
+            if (first_val == nullptr)
+                continue;
+            const auto rest_vals = std::make_tuple(rest.find(key)...);
+            const bool all_present = std::apply(
+                [](auto*... ptrs) { return ((ptrs != nullptr) && ...); }, rest_vals);
+            if (!all_present)
+                continue;
+            std::apply([&](auto*... ptrs) { func(key, *first_val, *ptrs...); }, rest_vals);
+        }
+    }
+} // namespace vex
@@ -0,0 +1,94 @@
+#include "StringTable.h"
+
+#include <vexcore/utils/HashUtils.h>
+
+#include <mutex>
+
+namespace vex {
+    namespace {
+        ExpandableBufferAllocator::State makeArenaState(Allocator al) {
+            ExpandableBufferAllocator::State state;
+            state.outer_allocator = al;
+            return state;
+        }
+    } // namespace
+
+    StringTable::StringTable(u32 arena_bytes, Allocator al)
+    : arena(arena_bytes, makeArenaState(al)), index(7, al), strings(al) {}
+
+    StringId StringTable::intern(std::string_view str) {
+        if (const StringId* found = index.find(str))
+            return *found;
+
+        char* mem = (char*)arena.alloc(str.size() + 1, 1);
+        if (!str.empty())
+            memcpy(mem, str.data(), str.size());
+        mem[str.size()] = '\0';
+
+        // Dict keeps the arena copy, caller's memory may go away
+        const std::string_view stored(mem, str.size());
+        strings.add(stored);
+        const StringId id{(u32)strings.size()};
+        index.emplace(stored, id);
+        return id;
+    }
+
+    StringId StringTable::find(std::string_view str) const {
+        const StringId* found = index.find(str);
+        return found != nullptr ? *found : StringId{};
+    }
+
+    ConcurrentStringTable::ConcurrentStringTable(u32 arena_bytes, Allocator al) : allocator(al) {
+        shards = vexAllocTyped<Shard>(allocator, k_num_shards);
+        for (u32 i = 0; i < k_num_shards; ++i)
+            new (&shards[i]) Shard(arena_bytes, al);
+    }
+
+    ConcurrentStringTable::~ConcurrentStringTable() {
+        for (u32 i = 0; i < k_num_shards; ++i)
+            shards[i].~Shard();
+        allocator.dealloc(shards);
+    }
+
+    u32 ConcurrentStringTable::shardOf(std::string_view str) {
+        return (u32)(util::hash64(str) >> (64 - k_shard_bits));
+    }
+
+    StringId ConcurrentStringTable::intern(std::string_view str) {
+        const u32 s = shardOf(str);
+        Shard& shard = shards[s];
+        {
+            std::shared_lock lock(shard.lock);
+            if (const StringId local = shard.table.find(str); local.isValid())
+                return toGlobal(local, s);
+        }
+
+        // other thread may have added it in between, intern() returns that id then
+        std::unique_lock lock(shard.lock);
+        const StringId local = shard.table.intern(str);
+        checkLethal(local.value < (1u << (32 - k_shard_bits)), "too many strings in shard");
+        return toGlobal(local, s);
+    }
+
+    StringId ConcurrentStringTable::find(std::string_view str) const {
+        const u32 s = shardOf(str);
+        std::shared_lock lock(shards[s].lock);
+        const StringId local = shards[s].table.find(str);
+        return local.isValid() ? toGlobal(local, s) : StringId{};
+    }
+
+    std::string_view ConcurrentStringTable::view(StringId id) const {
+        const Shard& shard = shards[id.value & (k_num_shards - 1)];
+        std::shared_lock lock(shard.lock);
+        return shard.table.view({id.value >> k_shard_bits});
+    }
+
+    auto ConcurrentStringTable::size() const -> i32 {
+        i32 total = 0;
+        for (u32 i = 0; i < k_num_shards; ++i) {
+            std::shared_lock lock(shards[i].lock);
+            total += shards[i].table.size();
+        }
+        return total;
+    }
+} // namespace vex
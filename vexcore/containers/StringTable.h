@@ -0,0 +1,116 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/Dict.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+
+#include <shared_mutex>
+#include <string_view>
+
+namespace vex {
+    /*
+     * Handle of an interned string: equal strings of one table get equal ids, so comparing
+     * and hashing them is an integer operation.
+     * Zero is never handed out, default constructed id is always invalid.
+     */
+    struct StringId {
+        u32 value = 0;
+
+        FORCE_INLINE constexpr auto isValid() const -> bool { return value != 0; }
+
+        friend constexpr bool operator==(StringId a, StringId b) { return a.value == b.value; }
+        friend constexpr bool operator!=(StringId a, StringId b) { return a.value != b.value; }
+    };
+
+    // ids are dense, so identity hashing already spreads them over prime-sized buckets
+    template <>
+    struct KeyHashEq<StringId> {
+        FORCE_INLINE static i32 hash(StringId id) { return (i32)id.value; }
+        FORCE_INLINE static bool is_equal(StringId a, StringId b) { return a == b; }
+    };
+
+    /*
+     * String interner: every unique string is copied once (null-terminated) into an
+     * ExpandableBufferAllocator arena and indexed by Dict<std::string_view, StringId>.
+     * Arena memory never moves, so views and c strings stay valid until the table dies.
+     * Strings are never removed.
+     * NOTE: not thread-safe, see ConcurrentStringTable.
+     */
+    class StringTable {
+    public:
+        static constexpr u32 k_default_arena_bytes = 16 * 1024;
+
+        explicit StringTable(u32 arena_bytes = k_default_arena_bytes, Allocator al = {});
+        StringTable(const StringTable&) = delete;
+        StringTable& operator=(const StringTable&) = delete;
+
+        // same string -> same id for the whole lifetime of the table
+        StringId intern(std::string_view str);
+        // invalid id if string was never interned
+        StringId find(std::string_view str) const;
+
+        FORCE_INLINE std::string_view view(StringId id) const {
+            checkAlwaysParanoid(id.isValid() && id.value <= (u32)strings.size(), "bad id");
+            return strings[id.value - 1];
+        }
+        FORCE_INLINE const char* cstr(StringId id) const { return view(id).data(); }
+
+        FORCE_INLINE auto size() const -> i32 { return strings.size(); }
+        // bytes taken from outer allocator for string data
+        FORCE_INLINE auto arenaBytes() const -> u32 { return arena.state.total_reserved; }
+
+    private:
+        ExpandableBufferAllocator arena;
+        Dict<std::string_view, StringId> index;
+        Buffer<std::string_view> strings; // id.value - 1 -> string
+    };
+
+    /*
+     * Thread-safe StringTable. Strings are spread over k_num_shards tables by hash, every
+     * shard has its own reader-writer lock, so threads interning different strings rarely
+     * wait for each other and lookups of already interned strings only take shared locks.
+     * Shard index lives in the low bits of StringId, ids are not dense across shards.
+     */
+    class ConcurrentStringTable {
+    public:
+        static constexpr u32 k_shard_bits = 4;
+        static constexpr u32 k_num_shards = 1u << k_shard_bits;
+
+        // arena_bytes is per shard
+        explicit ConcurrentStringTable(
+            u32 arena_bytes = StringTable::k_default_arena_bytes, Allocator al = {});
+        ConcurrentStringTable(const ConcurrentStringTable&) = delete;
+        ConcurrentStringTable& operator=(const ConcurrentStringTable&) = delete;
+        ~ConcurrentStringTable();
+
+        StringId intern(std::string_view str);
+        StringId find(std::string_view str) const;
+        // view stays valid after the lock is released, arena memory never moves
+        std::string_view view(StringId id) const;
+        FORCE_INLINE const char* cstr(StringId id) const { return view(id).data(); }
+
+        auto size() const -> i32;
+
+    private:
+        struct Shard {
+            mutable std::shared_mutex lock;
+            StringTable table;
+
+            Shard(u32 arena_bytes, Allocator al) : table(arena_bytes, al) {}
+        };
+
+        static u32 shardOf(std::string_view str);
+        FORCE_INLINE static StringId toGlobal(StringId local, u32 shard) {
+            return {(local.value << k_shard_bits) | shard};
+        }
+
+        // shards are not movable (mutex), so they are allocated once
+        Allocator allocator;
+        Shard* shards = nullptr;
+    };
+} // namespace vex
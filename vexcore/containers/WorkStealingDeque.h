@@ -0,0 +1,159 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Union.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <atomic>
+
+namespace vex {
+    enum class EStealResult : u8 {
+        Success,
+        Empty,
+        Lost, // other thief or owner took the element, worth retrying
+    };
+
+    /*
+     * Chase-Lev work-stealing deque (orderings from Le, Pop, Cohen, Nardelli 2013).
+     * Owner thread pushes and pops at the bottom (LIFO), any thread may steal from the top
+     * (FIFO) with a single CAS. Storage is a circular array that doubles when full.
+     *
+     * Thieves may still be reading an old array after growth, so replaced arrays are retired
+     * into a list and freed only in destructor (total retired memory is < current array).
+     * T is read speculatively by thieves, so it is stored in lock-free std::atomic<T> cells:
+     * meant for pointers, handles and small trivially copyable job descriptors.
+     */
+    template <typename T>
+    class WorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        static_assert(std::atomic<T>::is_always_lock_free, "T must fit into lock-free atomic");
+
+        struct Array {
+            i64 cap;
+            Array* retired_next; // older retired array
+            std::atomic<T> items[1];
+
+            FORCE_INLINE T get(i64 i) const {
+                return items[i & (cap - 1)].load(std::memory_order_relaxed);
+            }
+            FORCE_INLINE void put(i64 i, T val) {
+                items[i & (cap - 1)].store(val, std::memory_order_relaxed);
+            }
+        };
+
+    public:
+        using ValueType = T;
+
+        explicit WorkStealingDeque(Allocator al = {}, i32 in_cap = 64) : allocator(al) {
+            i64 cap = 2;
+            while (cap < in_cap)
+                cap *= 2;
+            array.store(allocArray(cap, nullptr), std::memory_order_relaxed);
+        }
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+        ~WorkStealingDeque() {
+            Array* a = array.load(std::memory_order_relaxed);
+            while (a) {
+                Array* next = a->retired_next;
+                vexFree(allocator, a);
+                a = next;
+            }
+        }
+
+        // approximate if called while deque is used
+        inline auto size() const -> i32 {
+            const i64 b = bottom.load(std::memory_order_relaxed);
+            const i64 t = top.load(std::memory_order_relaxed);
+            return b > t ? (i32)(b - t) : 0;
+        }
+        inline auto isEmpty() const -> bool { return size() == 0; }
+        inline auto capacity() const -> i32 {
+            return (i32)array.load(std::memory_order_relaxed)->cap;
+        }
+
+        // ---------------------------------------------------------------- owner only
+        void push(T val) {
+            const i64 b = bottom.load(std::memory_order_relaxed);
+            const i64 t = top.load(std::memory_order_acquire);
+            Array* a = array.load(std::memory_order_relaxed);
+            if (b - t > a->cap - 1)
+                a = grow(a, t, b);
+            a->put(b, val);
+            // release store instead of the paper's release fence + relaxed store: same cost,
+            // and visible to race detectors that don't model fences
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        [[nodiscard]] auto pop() -> vex::Option<T> {
+            const i64 b = bottom.load(std::memory_order_relaxed) - 1;
+            Array* a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 t = top.load(std::memory_order_relaxed);
+
+            if (t > b) { // was empty
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return {};
+            }
+            T val = a->get(b);
+            if (t == b) {
+                // last element, race with thieves for it
+                const bool won = top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won)
+                    return {};
+            }
+            return Option<T>{val};
+        }
+
+        // ---------------------------------------------------------------- any thread
+        EStealResult steal(T& out) {
+            i64 t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const i64 b = bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return EStealResult::Empty;
+
+            // acquire pairs with release store in grow, array contents are visible
+            Array* a = array.load(std::memory_order_acquire);
+            const T val = a->get(t);
+            if (!top.compare_exchange_strong(
+                    t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return EStealResult::Lost;
+            out = val;
+            return EStealResult::Success;
+        }
+
+    private:
+        Array* allocArray(i64 cap, Array* retired) {
+            const u64 bytes = sizeof(Array) + (u64)(cap - 1) * sizeof(std::atomic<T>);
+            Array* a = (Array*)vexAlloc(allocator, bytes, alignof(Array));
+            checkLethal(a, "failure of allocator");
+            a->cap = cap;
+            a->retired_next = retired;
+            for (i64 i = 0; i < cap; ++i)
+                new (&a->items[i]) std::atomic<T>();
+            return a;
+        }
+
+        Array* grow(Array* old, i64 t, i64 b) {
+            Array* a = allocArray(old->cap * 2, old);
+            for (i64 i = t; i < b; ++i)
+                a->put(i, old->get(i));
+            array.store(a, std::memory_order_release);
+            return a;
+        }
+
+        alignas(64) std::atomic<i64> top{0};
+        alignas(64) std::atomic<i64> bottom{0};
+        alignas(64) std::atomic<Array*> array{nullptr};
+        Allocator allocator;
+    };
+} // namespace vex
@@ -0,0 +1,293 @@
+#include "JobSystem.h"
+
+#include <vexcore/containers/Array.h>
+
+namespace vex {
+    namespace {
+        thread_local const JobSystem* tls_system = nullptr;
+        thread_local i32 tls_worker = -1;
+        thread_local Job* tls_job = nullptr;
+
+        constexpr i32 k_idle_spins = 64;
+
+        FORCE_INLINE u64 nextRandom(u64& state) {
+            // xorshift64*, only used to pick steal victims
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1Dull;
+        }
+
+        // handle may ignore alignment (malloc), so over-allocate and align manually,
+        // 'memory' receives the pointer that has to be freed
+        template <typename T>
+        T* allocAligned(Allocator& al, u64 num, u8*& memory) {
+            memory = vexAlloc(al, num * sizeof(T) + alignof(T), alignof(T));
+            checkLethal(memory, "failure of allocator");
+            const u64 addr = (u64)memory;
+            return (T*)(memory + ((alignof(T) - (addr % alignof(T))) % alignof(T)));
+        }
+    } // namespace
+
+    struct alignas(64) JobSystem::Worker {
+        struct JobPage {
+            Job* jobs = nullptr;
+            u8* memory = nullptr; // unaligned, as returned by allocator
+        };
+
+        WorkStealingDeque<Job*> deque;
+        Buffer<JobPage> job_pages;
+        u32 next_job = 0; // round-robin cursor over all pages
+        u64 rng_state = 0;
+        u8* scratch_memory = nullptr;
+        BumpAllocator scratch;
+
+        explicit Worker(Allocator al) : deque(al, 256), job_pages(al) {}
+
+        Job* addJobPage(Allocator& al) {
+            JobPage page;
+            page.jobs = allocAligned<Job>(al, k_jobs_per_worker, page.memory);
+            for (u32 j = 0; j < k_jobs_per_worker; ++j)
+                new (page.jobs + j) Job();
+            job_pages.add(page);
+            return page.jobs;
+        }
+
+        // slot is free once its job and all of its children are finished, nullptr if every
+        // slot is still in flight
+        Job* findFreeJob() {
+            const u32 total = (u32)job_pages.size() * k_jobs_per_worker;
+            for (u32 tries = 0; tries < total; ++tries) {
+                const u32 i = next_job;
+                next_job = next_job + 1 < total ? next_job + 1 : 0;
+                Job* job = &job_pages[i / k_jobs_per_worker].jobs[i % k_jobs_per_worker];
+                if (job->unfinished.load(std::memory_order_acquire) == 0)
+                    return job;
+            }
+            return nullptr;
+        }
+    };
+
+    JobSystem::JobSystem(i32 num_threads, u32 scratch_bytes, Allocator al) : allocator(al) {
+        // worker identity is a single thread_local slot, second system would overwrite it
+        checkLethal(tls_system == nullptr, "only one JobSystem per thread");
+        if (num_threads <= 0)
+            num_threads = (i32)std::thread::hardware_concurrency();
+        num_workers = num_threads > 0 ? num_threads : 1;
+
+        workers = allocAligned<Worker>(allocator, num_workers, workers_memory);
+        for (i32 i = 0; i < num_workers; ++i) {
+            Worker* w = new (workers + i) Worker(allocator);
+            w->addJobPage(allocator);
+            w->rng_state = 0x9E3779B97F4A7C15ull * (u64)(i + 1);
+            w->scratch_memory = vexAlloc(allocator, scratch_bytes, 16);
+            checkLethal(w->scratch_memory, "failure of allocator");
+            w->scratch = BumpAllocator{w->scratch_memory, scratch_bytes};
+        }
+
+        tls_system = this;
+        tls_worker = 0;
+
+        if (num_workers > 1) {
+            threads = vexAllocTyped<std::thread>(allocator, num_workers - 1);
+            checkLethal(threads, "failure of allocator");
+            for (i32 i = 1; i < num_workers; ++i)
+                new (threads + i - 1) std::thread([this, i] { workerLoop(i); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        running.store(false, std::memory_order_seq_cst);
+        wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+        wake_epoch.notify_all();
+        for (i32 i = 0; i < num_workers - 1; ++i) {
+            threads[i].join();
+            threads[i].~thread();
+        }
+        vexFree(allocator, threads);
+
+        for (i32 i = 0; i < num_workers; ++i) {
+            Worker& w = workers[i];
+            for (const Worker::JobPage& page : w.job_pages)
+                vexFree(allocator, page.memory);
+            vexFree(allocator, w.scratch_memory);
+            w.~Worker();
+        }
+        vexFree(allocator, workers_memory);
+
+        checkLethal(tls_system == this, "JobSystem must be destroyed by its creator thread");
+        tls_system = nullptr;
+        tls_worker = -1;
+    }
+
+    auto JobSystem::currentWorker() const -> i32 { return tls_system == this ? tls_worker : -1; }
+
+    auto JobSystem::currentJob() const -> JobHandle {
+        if (tls_system != this || tls_job == nullptr)
+            return {};
+        return {tls_job, tls_job->generation.load(std::memory_order_relaxed)};
+    }
+
+    Job* JobSystem::allocJob(JobHandle parent) {
+        const i32 index = currentWorker();
+        checkLethal(index >= 0, "jobs can only be created from worker threads");
+        Worker& w = workers[index];
+
+        // waiting for a live slot could wait for the calling job itself or its ancestors,
+        // so the pool grows instead (job trees wider than the pool, deep recursion)
+        Job* job = w.findFreeJob();
+        if (!job) {
+            w.next_job = (u32)w.job_pages.size() * k_jobs_per_worker + 1;
+            job = w.addJobPage(allocator);
+        }
+
+        job->generation.fetch_add(1, std::memory_order_relaxed);
+        job->parent = addChild(parent) ? parent.job : nullptr;
+        // release: whoever increments this count as a parent also sees the new generation
+        job->unfinished.store(1, std::memory_order_release);
+        return job;
+    }
+
+    bool JobSystem::addChild(JobHandle parent) {
+        if (!parent.isValid())
+            return false;
+        // parent may finish and its slot may be reused at any moment: count is only
+        // incremented while it is non-zero, so finished job is never revived ...
+        Job* job = parent.job;
+        i32 count = job->unfinished.load(std::memory_order_relaxed);
+        do {
+            if (count == 0)
+                return false;
+        } while (!job->unfinished.compare_exchange_weak(
+            count, count + 1, std::memory_order_acquire, std::memory_order_relaxed));
+        // ... and the slot can't be reused while we hold it, so generation is stable now
+        if (job->generation.load(std::memory_order_relaxed) == parent.generation)
+            return true;
+        // it is a newer job in the same slot, give the count back as if a child finished
+        finish(job);
+        return false;
+    }
+
+    JobHandle JobSystem::submit(Job* job) {
+        const JobHandle handle{job, job->generation.load(std::memory_order_relaxed)};
+        workers[tls_worker].deque.push(job);
+        wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0)
+            wake_epoch.notify_one();
+        return handle;
+    }
+
+    void JobSystem::execute(Job* job) {
+        Job* prev = tls_job;
+        tls_job = job;
+        job->func(*job);
+        tls_job = prev;
+        finish(job);
+    }
+
+    void JobSystem::finish(Job* job) {
+        // parent has to be read before the slot is released
+        while (job) {
+            Job* parent = job->parent;
+            if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            job = parent;
+        }
+    }
+
+    Job* JobSystem::findJob(Worker& self) {
+        if (auto own = self.deque.pop(); own.hasAnyValue())
+            return own.template get<Job*>();
+
+        if (num_workers == 1)
+            return nullptr;
+        // random victims first, then one full sweep so work is not missed
+        for (i32 attempt = 0; attempt < num_workers * 2; ++attempt) {
+            const i32 victim = (i32)(nextRandom(self.rng_state) % (u64)num_workers);
+            Worker& w = workers[victim];
+            if (&w == &self)
+                continue;
+            Job* job = nullptr;
+            EStealResult res = w.deque.steal(job);
+            if (res == EStealResult::Success)
+                return job;
+        }
+        // lost steal means the deque had work, so the victim is retried until it is empty
+        for (i32 i = 0; i < num_workers; ++i) {
+            Worker& w = workers[i];
+            if (&w == &self)
+                continue;
+            Job* job = nullptr;
+            EStealResult res = w.deque.steal(job);
+            while (res == EStealResult::Lost)
+                res = w.deque.steal(job);
+            if (res == EStealResult::Success)
+                return job;
+        }
+        return nullptr;
+    }
+
+    bool JobSystem::helpOnce() {
+        const i32 index = currentWorker();
+        checkLethal(index >= 0, "only worker threads can execute jobs");
+        Job* job = findJob(workers[index]);
+        if (!job)
+            return false;
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::wait(JobHandle handle) {
+        while (!handle.isDone()) {
+            if (!helpOnce())
+                std::this_thread::yield();
+        }
+    }
+
+    bool JobSystem::hasVisibleWork() const {
+        for (i32 i = 0; i < num_workers; ++i)
+            if (!workers[i].deque.isEmpty())
+                return true;
+        return false;
+    }
+
+    void JobSystem::workerLoop(i32 index) {
+        tls_system = this;
+        tls_worker = index;
+        Worker& self = workers[index];
+
+        i32 idle = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            if (Job* job = findJob(self)) {
+                execute(job);
+                idle = 0;
+                continue;
+            }
+            if (++idle < k_idle_spins) {
+                std::this_thread::yield();
+                continue;
+            }
+            // sleep until somebody submits, epoch is read before re-checking deques so a
+            // submit that happens after the check changes it and wait() returns immediately
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            const u32 epoch = wake_epoch.load(std::memory_order_seq_cst);
+            if (!hasVisibleWork() && running.load(std::memory_order_seq_cst))
+                wake_epoch.wait(epoch, std::memory_order_seq_cst);
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+        tls_system = nullptr;
+        tls_worker = -1;
+    }
+
+    auto JobSystem::scratch() -> BumpAllocator& {
+        const i32 index = currentWorker();
+        checkLethal(index >= 0, "scratch is only available on worker threads");
+        return workers[index].scratch;
+    }
+
+    void JobSystem::resetScratch() {
+        for (i32 i = 0; i < num_workers; ++i)
+            workers[i].scratch.reset();
+    }
+} // namespace vex
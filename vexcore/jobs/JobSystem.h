@@ -0,0 +1,166 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/WorkStealingDeque.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <atomic>
+#include <thread>
+
+namespace vex {
+    /*
+     * Unit of work, callable is stored inline (no allocation per job).
+     * 'unfinished' counts job itself plus its not yet finished children.
+     */
+    struct alignas(64) Job {
+        static constexpr u32 k_payload_bytes = 40;
+
+        void (*func)(Job&) = nullptr;
+        Job* parent = nullptr;
+        std::atomic<i32> unfinished{0};
+        std::atomic<u32> generation{0};
+        alignas(8) u8 payload[k_payload_bytes];
+    };
+    static_assert(sizeof(Job) == 64, "job should take exactly one cache line");
+
+    // weak reference to a job, stays valid (reports done) after job slot is reused
+    struct JobHandle {
+        Job* job = nullptr;
+        u32 generation = 0;
+
+        FORCE_INLINE auto isValid() const -> bool { return job != nullptr; }
+        FORCE_INLINE auto isDone() const -> bool {
+            return job == nullptr ||
+                   job->unfinished.load(std::memory_order_acquire) == 0 ||
+                   job->generation.load(std::memory_order_acquire) != generation;
+        }
+    };
+
+    /*
+     * Work-stealing thread pool.
+     * Thread that creates JobSystem becomes worker 0, (num_threads - 1) threads are spawned.
+     * A thread can be worker 0 of only one JobSystem at a time, and it has to be the one
+     * that destroys it.
+     * Every worker has its own WorkStealingDeque: jobs are pushed to the deque of the worker
+     * that creates them, idle workers steal from random victims and sleep (atomic wait) when
+     * there is nothing to steal for a while.
+     *
+     * Jobs may only be created from worker threads (including worker 0). Job storage is a
+     * pool of pages per worker, slots are reused round-robin once their job and all of its
+     * children are finished. When every slot is in flight a new page is added, pages are
+     * kept until JobSystem is destroyed.
+     * wait() never blocks while there is work: waiting thread executes other jobs.
+     *
+     * Every worker also owns a scratch BumpAllocator, meant for temporary allocations inside
+     * jobs. It is never reset automatically, use resetScratch() when no jobs are running.
+     */
+    class JobSystem {
+    public:
+        static constexpr u32 k_jobs_per_worker = 4096; // slots per pool page
+        static constexpr u32 k_default_scratch_bytes = 256 * 1024;
+
+        // num_threads <= 0 -> std::thread::hardware_concurrency()
+        explicit JobSystem(i32 num_threads = 0, u32 scratch_bytes = k_default_scratch_bytes,
+            Allocator al = {});
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        // jobs that were not waited for are dropped
+        ~JobSystem();
+
+        FORCE_INLINE auto workerCount() const -> i32 { return num_workers; }
+        // index of calling thread in this system, -1 for foreign threads
+        auto currentWorker() const -> i32;
+        // job that calling thread executes right now (invalid outside of jobs)
+        auto currentJob() const -> JobHandle;
+
+        template <typename TFunc>
+        JobHandle run(TFunc&& func) {
+            return runChild(JobHandle{}, std::forward<TFunc>(func));
+        }
+        // parent is considered unfinished until all its children are finished, parent that
+        // is already done (or whose slot was reused) is ignored
+        template <typename TFunc>
+        JobHandle runChild(JobHandle parent, TFunc&& func) {
+            using F = std::decay_t<TFunc>;
+            static_assert(sizeof(F) <= Job::k_payload_bytes,
+                "callable does not fit into job, capture by reference or pointer");
+            static_assert(alignof(F) <= 8, "overaligned callable");
+
+            Job* job = allocJob(parent);
+            new (job->payload) F(std::forward<TFunc>(func));
+            job->func = [](Job& j) {
+                F* f = reinterpret_cast<F*>(j.payload);
+                (*f)();
+                f->~F();
+            };
+            return submit(job);
+        }
+
+        void wait(JobHandle handle);
+        // runs one pending job if there is any, returns false if nothing was found
+        bool helpOnce();
+
+        /*
+         * Calls func(Range sub_range) for disjoint sub ranges of at most 'grain' elements that
+         * cover 'range', returns when all of them are done. Ranges are split recursively in
+         * halves, so thieves take big chunks first.
+         */
+        template <typename TFunc>
+        void parallelFor(Range range, i32 grain, TFunc&& func) {
+            grain = grain > 0 ? grain : 1;
+            const i32 start = range.range_start;
+            const i32 end = range.range_end;
+            if (end <= start)
+                return;
+            if (end - start <= grain || num_workers == 1) {
+                func(Range(start, end));
+                return;
+            }
+            const auto* fn = &func;
+            wait(run([this, fn, start, end, grain] { splitFor(fn, start, end, grain); }));
+        }
+
+        // scratch allocator of calling worker
+        auto scratch() -> BumpAllocator&;
+        void resetScratch();
+
+    private:
+        struct Worker;
+
+        template <typename TFunc>
+        void splitFor(const TFunc* fn, i32 start, i32 end, i32 grain) {
+            const JobHandle self = currentJob();
+            while (end - start > grain) {
+                const i32 mid = start + (end - start) / 2;
+                runChild(self, [this, fn, mid, end, grain] { splitFor(fn, mid, end, grain); });
+                end = mid;
+            }
+            (*fn)(Range(start, end));
+        }
+
+        Job* allocJob(JobHandle parent);
+        // true if parent was still running and now also waits for a new child
+        static bool addChild(JobHandle parent);
+        JobHandle submit(Job* job);
+        void execute(Job* job);
+        static void finish(Job* job);
+        Job* findJob(Worker& self);
+        bool hasVisibleWork() const;
+        void workerLoop(i32 index);
+
+        Allocator allocator;
+        Worker* workers = nullptr;
+        u8* workers_memory = nullptr; // unaligned, as returned by allocator
+        std::thread* threads = nullptr;
+        i32 num_workers = 0;
+
+        std::atomic<bool> running{true};
+        alignas(64) std::atomic<u32> wake_epoch{0};
+        alignas(64) std::atomic<i32> sleepers{0};
+    };
+} // namespace vex
@@ -0,0 +1,309 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/ConcurrentRing.h>
+#include <vexcore/jobs/JobSystem.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+namespace vex {
+    template <typename T>
+    class Task;
+
+    namespace task_impl {
+        /*
+         * Frame allocation: Allocator handle is stored in front of the frame so operator delete
+         * can return memory to the same place. Coroutine picks allocator by its parameters:
+         *     Task<i32> foo(vex::Allocator al, ...);                        // first parameter
+         *     Task<i32> foo(std::allocator_arg_t, vex::Allocator al, ...);  // std convention
+         * otherwise frame comes from default handle (malloc).
+         */
+        struct FrameAllocation {
+            static constexpr size_t k_header = 16;
+
+            static void* allocate(size_t size, Allocator al) {
+                u8* mem = al.alloc(size + k_header, k_header);
+                checkLethal(mem, "failure of coroutine frame allocator");
+                new (mem) Allocator(al);
+                return mem + k_header;
+            }
+            static void deallocate(void* frame) {
+                u8* mem = static_cast<u8*>(frame) - k_header;
+                Allocator al = *reinterpret_cast<Allocator*>(mem);
+                al.dealloc(mem);
+            }
+
+            static void* operator new(size_t size) { return allocate(size, {}); }
+            template <typename... TArgs>
+            static void* operator new(size_t size, Allocator& al, TArgs&...) {
+                return allocate(size, al);
+            }
+            template <typename... TArgs>
+            static void* operator new(size_t size, std::allocator_arg_t, Allocator& al, TArgs&...) {
+                return allocate(size, al);
+            }
+            static void operator delete(void* frame) { deallocate(frame); }
+        };
+
+        struct PromiseBase : FrameAllocation {
+            std::coroutine_handle<> continuation;
+            // set by whichever comes second: awaiting coroutine suspending or task finishing,
+            // the second one resumes the awaiting coroutine (see Task::operator co_await)
+            std::atomic<bool> rendezvous{false};
+            std::atomic<bool> finished{false};
+
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                template <typename TPromise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> h) noexcept {
+                    PromiseBase& p = h.promise();
+                    // read before 'finished' is published, owner may destroy frame right after
+                    std::coroutine_handle<> next = p.continuation;
+                    const bool awaiter_suspended = p.rendezvous.exchange(true);
+                    p.finished.store(true, std::memory_order_release);
+                    return (awaiter_suspended && next) ? next : std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() const noexcept { std::abort(); }
+        };
+
+        template <typename T>
+        struct Promise : PromiseBase {
+            union {
+                T value;
+            };
+            bool has_value = false;
+
+            Promise() {}
+            ~Promise() {
+                if (has_value)
+                    value.~T();
+            }
+
+            Task<T> get_return_object() noexcept;
+            template <typename TFwd>
+            void return_value(TFwd&& val) {
+                new (&value) T(std::forward<TFwd>(val));
+                has_value = true;
+            }
+            T take() { return std::move(value); }
+        };
+
+        template <>
+        struct Promise<void> : PromiseBase {
+            Task<void> get_return_object() noexcept;
+            void return_void() const noexcept {}
+            void take() const noexcept {}
+        };
+    } // namespace task_impl
+
+    /*
+     * Lazily started coroutine that produces T. Started either by co_await from other
+     * coroutine (runs inline, awaiting coroutine continues when it finishes, on the thread
+     * that finished it) or by start() from plain code.
+     * Task owns the frame, frame is destroyed with Task.
+     */
+    template <typename T = void>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = task_impl::Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+        explicit Task(Handle h) : handle(h) {}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                release();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+        ~Task() { release(); }
+
+        FORCE_INLINE auto isValid() const -> bool { return (bool)handle; }
+        // safe to call from any thread
+        FORCE_INLINE auto isDone() const -> bool {
+            return !handle || handle.promise().finished.load(std::memory_order_acquire);
+        }
+
+        // runs the coroutine on calling thread until its first suspension
+        void start() {
+            checkLethal(handle && !handle.promise().continuation, "task is already awaited");
+            handle.resume();
+        }
+        // moves result out, task must be done
+        T result() {
+            checkLethal(isDone() && handle, "task is not finished");
+            return handle.promise().take();
+        }
+
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                Handle h;
+                bool await_ready() const noexcept { return !h || h.done(); }
+                // task runs inline, if it completes synchronously awaiting coroutine continues
+                // without suspending, so long chains of such awaits don't need tail calls
+                bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    promise_type& p = h.promise();
+                    p.continuation = awaiting;
+                    h.resume();
+                    return !p.rendezvous.exchange(true);
+                }
+                T await_resume() { return h.promise().take(); }
+            };
+            return Awaiter{handle};
+        }
+
+    private:
+        void release() {
+            if (handle)
+                handle.destroy();
+            handle = {};
+        }
+
+        Handle handle;
+    };
+
+    namespace task_impl {
+        template <typename T>
+        Task<T> Promise<T>::get_return_object() noexcept {
+            return Task<T>{std::coroutine_handle<Promise<T>>::from_promise(*this)};
+        }
+        inline Task<void> Promise<void>::get_return_object() noexcept {
+            return Task<void>{std::coroutine_handle<Promise<void>>::from_promise(*this)};
+        }
+    } // namespace task_impl
+
+    // co_await resumeOn(jobs) continues the coroutine as a job, must be awaited on a worker
+    struct ResumeOnAwaiter {
+        JobSystem& jobs;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            jobs.run([h] { h.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    inline ResumeOnAwaiter resumeOn(JobSystem& jobs) { return {jobs}; }
+
+    // starts task on calling worker and helps with jobs until it is finished
+    template <typename T>
+    T syncWait(JobSystem& jobs, Task<T>& task) {
+        task.start();
+        while (!task.isDone()) {
+            if (!jobs.helpOnce())
+                std::this_thread::yield();
+        }
+        return task.result();
+    }
+
+    /*
+     * Parking slot for a single suspended coroutine (e.g. the consumer of SPSCRing).
+     * Producer publishes data first and then calls notify(), which resumes parked coroutine on
+     * the notifying thread or schedules it on JobSystem.
+     *
+     * 'state' is (epoch << 1) | parked, every park() hands out a ticket and both unpark and
+     * take move to the next epoch. A resumed coroutine can park again before the thread that
+     * parked it first gets to unpark(), stale ticket then fails instead of stealing the new
+     * parking.
+     */
+    class CoroWaiter {
+    public:
+        using Ticket = u64;
+
+        // 0 if other coroutine is parked already
+        Ticket park(std::coroutine_handle<> h) {
+            u64 s = state.load();
+            if (s & k_parked)
+                return 0;
+            // only the parking side writes it, notifier reads it after taking the parking
+            handle.store(h.address(), std::memory_order_relaxed);
+            if (!state.compare_exchange_strong(s, s | k_parked))
+                return 0;
+            return s | k_parked;
+        }
+        // false if notifier already took this parking (it will resume the coroutine)
+        bool unpark(Ticket ticket) {
+            u64 expected = ticket;
+            return state.compare_exchange_strong(expected, nextEpoch(ticket));
+        }
+        auto take() -> std::coroutine_handle<> {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            u64 s = state.load();
+            while (s & k_parked) {
+                if (state.compare_exchange_weak(s, nextEpoch(s)))
+                    return std::coroutine_handle<>::from_address(
+                        handle.load(std::memory_order_relaxed));
+            }
+            return {};
+        }
+
+        void notify() {
+            if (std::coroutine_handle<> h = take())
+                h.resume();
+        }
+        void notify(JobSystem& jobs) {
+            if (std::coroutine_handle<> h = take())
+                jobs.run([h] { h.resume(); });
+        }
+
+    private:
+        static constexpr u64 k_parked = 1;
+        static FORCE_INLINE u64 nextEpoch(u64 s) { return (s | k_parked) + 1; }
+
+        std::atomic<u64> state{0};
+        std::atomic<void*> handle{nullptr};
+    };
+
+    /*
+     * co_await popWhenReady(ring, waiter) returns next element of SPSCRing, suspending while it
+     * is empty. Only the (single) consumer awaits, producer calls waiter.notify() after push.
+     */
+    template <typename TRing>
+    struct SPSCPopAwaiter {
+        using T = typename TRing::ValueType;
+
+        TRing& ring;
+        CoroWaiter& waiter;
+
+        bool await_ready() const noexcept { return !ring.isEmpty(); }
+        bool await_suspend(std::coroutine_handle<> h) {
+            // awaiter may be destroyed as soon as handle is published, work on copies
+            TRing& r = ring;
+            CoroWaiter& w = waiter;
+            const CoroWaiter::Ticket ticket = w.park(h);
+            checkLethal(ticket != 0, "only one coroutine can wait for SPSCRing");
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // element could arrive before we parked, then nobody would notify us
+            if (!r.isEmpty() && w.unpark(ticket))
+                return false;
+            return true;
+        }
+        T await_resume() {
+            auto item = ring.tryPop();
+            checkLethal(item.hasAnyValue(), "resumed with empty ring");
+            return std::move(item.template get<T>());
+        }
+    };
+    template <typename TRing>
+    SPSCPopAwaiter<TRing> popWhenReady(TRing& ring, CoroWaiter& waiter) {
+        return {ring, waiter};
+    }
+} // namespace vex
@@ -0,0 +1,136 @@
+#include "TaskGraph.h"
+
+namespace vex {
+    void TaskGraph::precede(TaskId before, TaskId after) {
+        checkLethal(before >= 0 && before < nodes.size(), "invalid task id");
+        checkLethal(after >= 0 && after < nodes.size(), "invalid task id");
+        checkLethal(before != after, "task can't depend on itself");
+        edges.add(Edge{before, after});
+        compiled = false;
+    }
+
+    void TaskGraph::compile() {
+        releaseCompiled();
+        const i32 num = nodes.size();
+
+        // successors grouped by TaskId (counting sort of edges by 'from')
+        Buffer<i32> offsets(allocator);
+        offsets.addZeroed(num + 1);
+        Buffer<i32> in_degree(allocator);
+        in_degree.addZeroed(num);
+        for (const Edge& e : edges) {
+            offsets[e.from + 1]++;
+            in_degree[e.to]++;
+        }
+        for (i32 i = 0; i < num; ++i)
+            offsets[i + 1] += offsets[i];
+        Buffer<i32> by_id(allocator);
+        by_id.addUninitialized(edges.size());
+        {
+            Buffer<i32> fill(offsets);
+            for (const Edge& e : edges)
+                by_id[fill[e.from]++] = e.to;
+        }
+
+        // Kahn's algorithm, 'order' doubles as the queue
+        order = Buffer<i32>(allocator, num);
+        Buffer<i32> remaining(in_degree);
+        for (i32 i = 0; i < num; ++i)
+            if (in_degree[i] == 0)
+                order.add(i);
+        for (i32 head = 0; head < order.size(); ++head) {
+            const i32 id = order[head];
+            for (i32 k = offsets[id]; k < offsets[id + 1]; ++k)
+                if (--remaining[by_id[k]] == 0)
+                    order.add(by_id[k]);
+        }
+        checkLethal(order.size() == num, "task graph has a cycle");
+
+        // re-index everything to topological positions
+        Buffer<i32> position(allocator);
+        position.addUninitialized(num);
+        for (i32 i = 0; i < num; ++i)
+            position[order[i]] = i;
+
+        succ_offsets = Buffer<i32>(allocator, num + 1);
+        succ = Buffer<i32>(allocator, edges.size());
+        dependencies = Buffer<i32>(allocator, num);
+        roots = Buffer<i32>(allocator);
+        succ_offsets.add(0);
+        for (i32 i = 0; i < num; ++i) {
+            const i32 id = order[i];
+            for (i32 k = offsets[id]; k < offsets[id + 1]; ++k)
+                succ.add(position[by_id[k]]);
+            succ_offsets.add(succ.size());
+            dependencies.add(in_degree[id]);
+            if (in_degree[id] == 0)
+                roots.add(i);
+        }
+
+        counters = vexAllocTyped<std::atomic<i32>>(allocator, num > 0 ? num : 1);
+        checkLethal(counters, "failure of allocator");
+        for (i32 i = 0; i < num; ++i)
+            new (counters + i) std::atomic<i32>(0);
+        compiled = true;
+    }
+
+    void TaskGraph::run(JobSystem& jobs) {
+        checkLethal(compiled, "task graph must be compiled before run");
+        if (nodes.size() == 0)
+            return;
+
+        for (i32 i = 0; i < nodes.size(); ++i)
+            counters[i].store(dependencies[i], std::memory_order_relaxed);
+
+        active_jobs = &jobs;
+        // every task job is a child of 'frame', so waiting on it waits for the whole graph
+        const JobHandle root = jobs.run([this] {
+            frame = active_jobs->currentJob();
+            for (i32 r : roots)
+                spawn(r);
+        });
+        jobs.wait(root);
+        active_jobs = nullptr;
+        frame = {};
+    }
+
+    void TaskGraph::spawn(i32 task) {
+        active_jobs->runChild(frame, [this, task] { execute(task); });
+    }
+
+    void TaskGraph::execute(i32 task) {
+        while (task >= 0) {
+            const Node& node = nodes[order[task]];
+            node.invoke(node.callable);
+
+            // first successor that becomes ready continues on this worker
+            i32 next = -1;
+            for (i32 k = succ_offsets[task]; k < succ_offsets[task + 1]; ++k) {
+                const i32 s = succ[k];
+                if (counters[s].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+                if (next < 0)
+                    next = s;
+                else
+                    spawn(s);
+            }
+            task = next;
+        }
+    }
+
+    void TaskGraph::releaseCompiled() {
+        vexFree(allocator, counters);
+        counters = nullptr;
+        compiled = false;
+    }
+
+    void TaskGraph::clear() {
+        releaseCompiled();
+        for (const Node& node : nodes) {
+            node.destroy(node.callable);
+            vexFree(allocator, node.callable);
+        }
+        nodes = Buffer<Node>(allocator);
+        edges = Buffer<Edge>(allocator);
+    }
+} // namespace vex
@@ -0,0 +1,101 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/jobs/JobSystem.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <atomic>
+
+namespace vex {
+    /*
+     * Static dependency graph of tasks that is declared once and executed many times
+     * (e.g. every frame: simulation -> culling -> packing).
+     *
+     * add()/precede() declare nodes and edges, compile() sorts nodes topologically (cycles are
+     * fatal) and lays out successors and dependency counters in that order. run() resets the
+     * counters and executes the graph on JobSystem: a task becomes ready when its counter hits
+     * zero, first ready successor is executed inline by the same worker, others are pushed as
+     * jobs. run() does not allocate, job storage comes from JobSystem pools (which only grow
+     * on the first runs of graphs wider than they are).
+     *
+     * Callables are stored in memory taken from the allocator handle, so an arena
+     * (ExpandableBufferAllocator) works well for graphs that are rebuilt from scratch.
+     */
+    class TaskGraph {
+    public:
+        using TaskId = i32;
+
+        explicit TaskGraph(Allocator al = {}) : allocator(al), nodes(al), edges(al) {}
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+        ~TaskGraph() { clear(); }
+
+        FORCE_INLINE auto size() const -> i32 { return nodes.size(); }
+        FORCE_INLINE auto isCompiled() const -> bool { return compiled; }
+
+        template <typename TFunc>
+        TaskId add(TFunc&& func) {
+            using F = std::decay_t<TFunc>;
+            void* storage = vexAlloc(allocator, sizeof(F), alignof(F));
+            checkLethal(storage, "failure of allocator");
+            new (storage) F(std::forward<TFunc>(func));
+
+            Node node;
+            node.callable = storage;
+            node.invoke = [](void* f) { (*static_cast<F*>(f))(); };
+            node.destroy = [](void* f) { static_cast<F*>(f)->~F(); };
+            nodes.add(node);
+            compiled = false;
+            return nodes.size() - 1;
+        }
+
+        // 'after' starts only when 'before' is finished
+        void precede(TaskId before, TaskId after);
+
+        void compile();
+        // executes whole graph and returns when every task is done, must be called from a
+        // worker thread of 'jobs'
+        void run(JobSystem& jobs);
+
+        // destroys all tasks and edges
+        void clear();
+
+    private:
+        struct Node {
+            void* callable = nullptr;
+            void (*invoke)(void*) = nullptr;
+            void (*destroy)(void*) = nullptr;
+        };
+        struct Edge {
+            TaskId from;
+            TaskId to;
+        };
+
+        void releaseCompiled();
+        void spawn(i32 task);
+        void execute(i32 task);
+
+        Allocator allocator;
+        Buffer<Node> nodes; // declaration order, owns callables
+        Buffer<Edge> edges;
+
+        // compiled layout, all in topological order (index = position in 'order')
+        Buffer<i32> order; // order[i] = TaskId
+        Buffer<i32> succ_offsets; // successors of i: succ[succ_offsets[i] .. succ_offsets[i+1])
+        Buffer<i32> succ;
+        Buffer<i32> dependencies; // number of predecessors
+        Buffer<i32> roots;
+        std::atomic<i32>* counters = nullptr;
+        bool compiled = false;
+
+        // valid during run()
+        JobSystem* active_jobs = nullptr;
+        JobHandle frame;
+    };
+} // namespace vex
@@ -91,7 +91,7 @@ namespace vex
         inline u8* alloc(u64 in_size, u64 al) override
         {
             Self* self = this;
-            auto al_offset = al - (self->state.top % al);
+            auto al_offset = (al - (self->state.top % al)) % al;
             in_size += al_offset;
 
             u64 new_top = self->state.top + in_size;
@@ -185,6 +185,9 @@ namespace vex
             state.grow_mult = growth_factor;
             makeNode(start_size);
         }
+        ExpandableBufferAllocator(const ExpandableBufferAllocator&) = delete;
+        ExpandableBufferAllocator& operator=(const ExpandableBufferAllocator&) = delete;
+        ~ExpandableBufferAllocator() { freeNodes(); }
 
         u8* alloc(u64 in_size, u64 al) override
         {
@@ -197,9 +200,15 @@ namespace vex
                 }
 
                 u64 grow = static_cast<u64>(std::ceil(bump.state.capacity * state.grow_mult));
-                u64 new_size = grow > in_size ? grow : in_size;
-
-                makeNode(new_size);
+                // node must also fit alignment padding, bump rejects top == capacity
+                u64 min_size = in_size + al + 1;
+                u64 new_size = grow > min_size ? grow : min_size;
+                // node size (with header) is u32, growth is capped there
+                constexpr u64 max_size = UINT32_MAX - header_size;
+                checkLethal(min_size <= max_size, "allocation is too big for one buffer node");
+                new_size = new_size < max_size ? new_size : max_size;
+
+                makeNode((u32)new_size);
             }
 
             checkAlwaysRel(false, "should never happen, possibly outer_allocator is at fault.");
@@ -238,6 +247,13 @@ namespace vex
         }
 
         void releaseAndReserveUsedSize()
+        {
+            freeNodes();
+            makeNode(std::exchange(state.total_reserved, 0));
+        }
+
+    private:
+        void freeNodes()
         {
             auto& bump = state.bump;
             auto& outer_allocator = state.outer_allocator;
@@ -251,11 +267,8 @@ namespace vex
                 node = next_to_dealoc;
             }
             bump.state = {};
-
-            makeNode(std::exchange(state.total_reserved, 0));
         }
 
-    private:
         void makeNode(u32 buffer_size)
         {
             auto& bump = state.bump;
@@ -276,7 +276,7 @@ namespace vex {
         int range_end = 0;
         int current = 0;
 
-        Range begin() noexcept { return Range{0, range_start, range_end}; };
+        Range begin() noexcept { return Range{range_start, range_start, range_end}; };
         impl::vxSentinel end() const noexcept { return k_seq_end; };
     };
 
@@ -0,0 +1,201 @@
+#include "HashUtils.h"
+
+#include <vexcore/utils/SimdKernels.h>
+
+#include <array>
+
+#if VEX_SIMD_X86 && defined(VEXCORE_x64)
+    #include <nmmintrin.h>
+    #define VEX_CRC32C_HW 1
+    #if defined(_MSC_VER)
+        #define VEX_TARGET_SSE42
+    #else
+        #define VEX_TARGET_SSE42 __attribute__((target("sse4.2")))
+    #endif
+#else
+    #define VEX_CRC32C_HW 0
+#endif
+
+namespace vex::util {
+    namespace {
+        // reflected Castagnoli polynomial
+        constexpr u32 k_crc32c_poly = 0x82F63B78;
+
+        using CrcTable = std::array<std::array<u32, 256>, 8>;
+        // slice-by-8: t[k][n] is crc of byte n followed by k zero bytes
+        constexpr CrcTable makeSliceTables() {
+            CrcTable t{};
+            for (u32 n = 0; n < 256; ++n) {
+                u32 crc = n;
+                for (u32 k = 0; k < 8; ++k)
+                    crc = (crc & 1) ? (crc >> 1) ^ k_crc32c_poly : crc >> 1;
+                t[0][n] = crc;
+            }
+            for (u32 n = 0; n < 256; ++n) {
+                for (u32 k = 1; k < 8; ++k)
+                    t[k][n] = (t[k - 1][n] >> 8) ^ t[0][t[k - 1][n] & 0xFF];
+            }
+            return t;
+        }
+        constexpr CrcTable k_slice = makeSliceTables();
+
+#if VEX_CRC32C_HW
+        /*
+         * 3-way interleave (Adler): crc32 instruction has latency 3 and throughput 1, so three
+         * independent streams over consecutive blocks keep the unit busy. Partial crcs are
+         * merged by "appending zeros" to the earlier one, which is a linear operator on crc
+         * bits applied through 4 byte-wise tables.
+         */
+        constexpr u64 k_long_block = 8192;
+        constexpr u64 k_short_block = 256;
+
+        using ShiftTable = std::array<std::array<u32, 256>, 4>;
+
+        constexpr u32 gf2MatrixTimes(const u32* mat, u32 vec) {
+            u32 sum = 0;
+            while (vec) {
+                if (vec & 1)
+                    sum ^= *mat;
+                vec >>= 1;
+                mat++;
+            }
+            return sum;
+        }
+        constexpr void gf2MatrixSquare(u32* square, const u32* mat) {
+            for (u32 n = 0; n < 32; ++n)
+                square[n] = gf2MatrixTimes(mat, mat[n]);
+        }
+        // operator that applies 'len' zero bytes to crc
+        constexpr ShiftTable makeShiftTable(u64 len) {
+            u32 even[32] = {};
+            u32 odd[32] = {};
+            odd[0] = k_crc32c_poly; // one zero bit
+            u32 row = 1;
+            for (u32 n = 1; n < 32; ++n) {
+                odd[n] = row;
+                row <<= 1;
+            }
+            gf2MatrixSquare(even, odd); // two zero bits
+            gf2MatrixSquare(odd, even); // four zero bits
+            // first square gives one zero byte, then every square doubles
+            const u32* op = nullptr;
+            for (;;) {
+                gf2MatrixSquare(even, odd);
+                len >>= 1;
+                if (len == 0) {
+                    op = even;
+                    break;
+                }
+                gf2MatrixSquare(odd, even);
+                len >>= 1;
+                if (len == 0) {
+                    op = odd;
+                    break;
+                }
+            }
+
+            ShiftTable t{};
+            for (u32 n = 0; n < 256; ++n) {
+                t[0][n] = gf2MatrixTimes(op, n);
+                t[1][n] = gf2MatrixTimes(op, n << 8);
+                t[2][n] = gf2MatrixTimes(op, n << 16);
+                t[3][n] = gf2MatrixTimes(op, n << 24);
+            }
+            return t;
+        }
+        constexpr ShiftTable k_shift_long = makeShiftTable(k_long_block);
+        constexpr ShiftTable k_shift_short = makeShiftTable(k_short_block);
+
+        FORCE_INLINE u32 shift(const ShiftTable& t, u32 crc) {
+            return t[0][crc & 0xFF] ^ t[1][(crc >> 8) & 0xFF] ^ t[2][(crc >> 16) & 0xFF] ^
+                   t[3][crc >> 24];
+        }
+        FORCE_INLINE u64 load64(const u8* p) {
+            u64 v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        template <u64 k_block>
+        VEX_TARGET_SSE42 FORCE_INLINE u64 crc3Way(
+            u64 crc0, const u8*& next, u64& len, const ShiftTable& t) {
+            while (len >= 3 * k_block) {
+                u64 crc1 = 0;
+                u64 crc2 = 0;
+                const u8* end = next + k_block;
+                do {
+                    crc0 = _mm_crc32_u64(crc0, load64(next));
+                    crc1 = _mm_crc32_u64(crc1, load64(next + k_block));
+                    crc2 = _mm_crc32_u64(crc2, load64(next + 2 * k_block));
+                    next += 8;
+                } while (next < end);
+                crc0 = shift(t, (u32)crc0) ^ crc1;
+                crc0 = shift(t, (u32)crc0) ^ crc2;
+                next += 2 * k_block;
+                len -= 3 * k_block;
+            }
+            return crc0;
+        }
+
+        VEX_TARGET_SSE42 u32 crc32cHw(const u8* data, u64 size, u32 crc) {
+            const u8* next = data;
+            u64 len = size;
+            u64 crc0 = ~crc;
+            while (len > 0 && ((uintptr_t)next & 7) != 0) {
+                crc0 = _mm_crc32_u8((u32)crc0, *next++);
+                len--;
+            }
+            crc0 = crc3Way<k_long_block>(crc0, next, len, k_shift_long);
+            crc0 = crc3Way<k_short_block>(crc0, next, len, k_shift_short);
+            while (len >= 8) {
+                crc0 = _mm_crc32_u64(crc0, load64(next));
+                next += 8;
+                len -= 8;
+            }
+            while (len > 0) {
+                crc0 = _mm_crc32_u8((u32)crc0, *next++);
+                len--;
+            }
+            return ~(u32)crc0;
+        }
+#endif
+
+        using CrcFunc = u32 (*)(const u8*, u64, u32);
+        CrcFunc pickCrc32c() {
+#if VEX_CRC32C_HW
+            if (simd::cpuFeatures().sse42)
+                return &crc32cHw;
+#endif
+            return &crc32cSlice8;
+        }
+    } // namespace
+
+    u32 crc32cSlice8(const u8* data, u64 size, u32 crc) {
+        crc = ~crc;
+        while (size > 0 && ((uintptr_t)data & 7) != 0) {
+            crc = k_slice[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+            size--;
+        }
+        while (size >= 8) {
+            u64 w;
+            memcpy(&w, data, sizeof(w));
+            w ^= crc;
+            crc = k_slice[7][w & 0xFF] ^ k_slice[6][(w >> 8) & 0xFF] ^
+                  k_slice[5][(w >> 16) & 0xFF] ^ k_slice[4][(w >> 24) & 0xFF] ^
+                  k_slice[3][(w >> 32) & 0xFF] ^ k_slice[2][(w >> 40) & 0xFF] ^
+                  k_slice[1][(w >> 48) & 0xFF] ^ k_slice[0][w >> 56];
+            data += 8;
+            size -= 8;
+        }
+        while (size > 0) {
+            crc = k_slice[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+            size--;
+        }
+        return ~crc;
+    }
+
+    u32 crc32c(const u8* data, u64 size, u32 crc) {
+        static const CrcFunc g_crc32c = pickCrc32c();
+        return g_crc32c(data, size, crc);
+    }
+} // namespace vex::util
@@ -4,9 +4,14 @@
  * Copyright (c) 2019 Vladyslav Joss
  */
 #include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/Rng.h>
+
+#include <string.h>
 
 #include <bit>
 #include <random>
+#include <string>
+#include <string_view>
 
 #if INTPTR_MAX == INT64_MAX
     #define VEXCORE_x64
@@ -16,6 +21,15 @@
     #error Unknown ptr size, abort
 #endif
 
+#if defined(_MSC_VER) && defined(VEXCORE_x64)
+    #include <intrin.h>
+#endif
+
+namespace vex::simd {
+    // SimdKernels.h, see comment in Rng.h
+    void hashAccumulate(u64* acc, const u8* data, u64 num_blocks);
+} // namespace vex::simd
+
 #pragma warning(push)
 #pragma warning(disable : 26495)
 #pragma warning(disable : 26451)
@@ -24,55 +38,6 @@
 #pragma warning(pop)
 
 namespace vex {
-    namespace rng {
-        struct Splitmix64 {
-            static constexpr auto magic = u64(0x9E3779B97F4A7C15);
-            u64 state = 4999559;
-            inline void seed(u64 seed) { state = seed; }
-
-            static FORCE_INLINE u64 splitmix64_mut(u64& seed) {
-                u64 z = (seed += magic);
-                z = (z ^ (z >> 30)) * u64(0xBF58476D1CE4E5B9);
-                z = (z ^ (z >> 27)) * u64(0x94D049BB133111EB);
-                return z ^ (z >> 31);
-            }
-            static FORCE_INLINE u64 stateless(u64 in_seed, u64 offset) {
-                in_seed += offset * magic;
-                return splitmix64_mut(in_seed);
-            }
-            FORCE_INLINE u32 next() { return (u32)splitmix64_mut(state); }
-            FORCE_INLINE u64 next64() { return splitmix64_mut(state); }
-        };
-
-        struct Rand {
-            using Engine = Splitmix64;
-            static inline Engine g_shared{};
-            Engine engine = Engine{};
-
-            // Init with C rand() (usually a mistake)
-            static inline Rand make() { return Rand{.engine = {.state = (u64)(::rand())}}; }
-            // Init with seed
-            static inline Rand make(u64 seed) { return Rand{.engine = {.state = seed}}; }
-
-            FORCE_INLINE u32 rand() { return engine.next(); }
-            FORCE_INLINE u64 rand64() { return engine.next64(); }
-            FORCE_INLINE u32 randMod(u32 mod) { return engine.next() % mod; }
-            FORCE_INLINE float rand01() { return toFloatExpCast(engine.next()); }
-            FORCE_INLINE double randDouble01() { return toDoubleCast(engine.next64()); } 
-        private:
-#pragma warning(push)
-#pragma warning(disable : 4244) 
-            static FORCE_INLINE float toFloatExpCast(u32 v) { return v * (1.0f / 4294967296.0f); }
-#pragma warning(pop)
-            static constexpr FORCE_INLINE double toDoubleCast(u64 val) {
-                constexpr u64 exp = u64(0x3FF0000000000000);
-                constexpr u64 mantissa = u64(0x000FFFFFFFFFFFFF);
-                u64 random = (val & mantissa) | exp;
-                return std::bit_cast<double>(random) - 1;
-            }
-        };
-    } // namespace rng
-
     namespace util {
         static constexpr i32 gPrimeNumbers[] = {3, 7, 11, 17, 23, 29, 37, 47, 59, 71, 89, 107, 131,
             163, 197, 239, 293, 353, 431, 521, 631, 761, 919, 1103, 1327, 1597, 1931, 2333, 2801,
@@ -135,12 +100,13 @@ namespace vex {
             return findUpperBound(gPrimeNumbers, gPrimeSize, value);
         }
 
+        // exclusive, as it is more common use case; per-thread generator seeded once
         inline i32 randomRange(i32 fromInc, i32 toExc) {
-            static std::random_device rd;
-            static std::mt19937 mt(rd());
-            std::uniform_int_distribution<int> dist(fromInc,
-                toExc - 1); // exclusive, as it is more common use case
-            return dist(mt);
+            static thread_local rng::RandXoshiro256 g_rng = [] {
+                std::random_device rd;
+                return rng::RandXoshiro256::make(((u64)rd() << 32) | rd());
+            }();
+            return g_rng.randRange(fromInc, toExc);
         }
 
         static constexpr u64 k_fnv_prime = 16777619u;
@@ -179,16 +145,167 @@ namespace vex {
             return fnv1a<b64>((u8*)&obj, sizeof(T));
         }
 
-        static inline i32 hash(char* c, i32 sz) { return (i32)murmur::MurmurHash3_x86_32(c, sz); }
+        /*
+         * hash64: 64-bit byte hash, wyhash-style multiply-fold (64x64 -> 128, xor halves).
+         * Short inputs (<= 16 bytes) take two overlapping reads and one mix, medium inputs go
+         * 48 bytes per iteration in three independent lanes. Inputs of k_hash_long_block bytes
+         * and more are reduced by simd::hashAccumulate (8 x 64-bit accumulators, xxh3-like
+         * stripes, SSE2/AVX2 with identical results on all paths) and folded back in.
+         * Assumes little-endian, result is stable across platforms and instruction sets.
+         */
+        static constexpr u64 k_hash_p0 = 0xA0761D6478BD642Full;
+        static constexpr u64 k_hash_p1 = 0xE7037ED1A0B428DBull;
+        static constexpr u64 k_hash_p2 = 0x8EBC6AF09C88C6E3ull;
+        static constexpr u64 k_hash_p3 = 0x589965CC75374CC3ull;
+        static constexpr u64 k_hash_long_block = 1024;
 
-        struct SHash {
-            static inline i32 hash(const std::string& str) {
-#ifdef ECSCORE_x64
-                return (i32)murmur::MurmurHash3_x86_32(str.shrink_x_to_y(), (i32)str.size());
+        namespace hash_impl {
+            FORCE_INLINE void mum(u64& a, u64& b) {
+#if defined(__SIZEOF_INT128__)
+                const __uint128_t r = (__uint128_t)a * b;
+                a = (u64)r;
+                b = (u64)(r >> 64);
+#elif defined(_MSC_VER) && defined(VEXCORE_x64)
+                a = _umul128(a, b, &b);
 #else
-                return fnv1a((u8*)str.data(), str.length());
+                const u64 ha = a >> 32, hb = b >> 32, la = (u32)a, lb = (u32)b;
+                const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+                const u64 t = rl + (rm0 << 32);
+                const u64 lo = t + (rm1 << 32);
+                const u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+                a = lo;
+                b = hi;
 #endif
             }
+            FORCE_INLINE u64 mix(u64 a, u64 b) {
+                mum(a, b);
+                return a ^ b;
+            }
+            FORCE_INLINE u64 read64(const u8* p) {
+                u64 v;
+                memcpy(&v, p, sizeof(v));
+                return v;
+            }
+            FORCE_INLINE u64 read32(const u8* p) {
+                u32 v;
+                memcpy(&v, p, sizeof(v));
+                return v;
+            }
+            // 1..3 bytes
+            FORCE_INLINE u64 read3(const u8* p, u64 len) {
+                return ((u64)p[0] << 16) | ((u64)p[len >> 1] << 8) | p[len - 1];
+            }
+        } // namespace hash_impl
+
+        inline u64 hash64(const void* data, u64 len, u64 seed = 0) {
+            using namespace hash_impl;
+            const u8* p = (const u8*)data;
+            seed ^= mix(seed ^ k_hash_p0, k_hash_p1);
+            u64 a, b;
+            if (len <= 16) [[likely]] {
+                if (len >= 4) [[likely]] {
+                    const u64 mid = (len >> 3) << 2;
+                    a = (read32(p) << 32) | read32(p + mid);
+                    b = (read32(p + len - 4) << 32) | read32(p + len - 4 - mid);
+                } else if (len > 0) {
+                    a = read3(p, len);
+                    b = 0;
+                } else {
+                    a = b = 0;
+                }
+            } else {
+                u64 rest = len;
+                if (rest >= k_hash_long_block) [[unlikely]] {
+                    u64 acc[8] = {seed, k_hash_p0, k_hash_p1, k_hash_p2,
+                        k_hash_p3, seed ^ k_hash_p1, seed ^ k_hash_p2, ~seed};
+                    const u64 blocks = rest / k_hash_long_block;
+                    simd::hashAccumulate(acc, p, blocks);
+                    for (u32 i = 0; i < 8; i += 2)
+                        seed = mix(acc[i] ^ k_hash_p1, acc[i + 1] ^ seed);
+                    p += blocks * k_hash_long_block;
+                    rest -= blocks * k_hash_long_block;
+                    // tail reads below overlap into the last block if less than 16 bytes left
+                    if (rest < 16) {
+                        p -= 16 - rest;
+                        rest = 16;
+                    }
+                }
+                if (rest > 48) {
+                    u64 see1 = seed, see2 = seed;
+                    do {
+                        seed = mix(read64(p) ^ k_hash_p1, read64(p + 8) ^ seed);
+                        see1 = mix(read64(p + 16) ^ k_hash_p2, read64(p + 24) ^ see1);
+                        see2 = mix(read64(p + 32) ^ k_hash_p3, read64(p + 40) ^ see2);
+                        p += 48;
+                        rest -= 48;
+                    } while (rest > 48);
+                    seed ^= see1 ^ see2;
+                }
+                while (rest > 16) {
+                    seed = mix(read64(p) ^ k_hash_p1, read64(p + 8) ^ seed);
+                    p += 16;
+                    rest -= 16;
+                }
+                a = read64(p + rest - 16);
+                b = read64(p + rest - 8);
+            }
+            a ^= k_hash_p1;
+            b ^= seed;
+            mum(a, b);
+            return mix(a ^ k_hash_p0 ^ len, b ^ k_hash_p1);
+        }
+        FORCE_INLINE u64 hash64(std::string_view str, u64 seed = 0) {
+            return hash64(str.data(), str.size(), seed);
+        }
+        // Dict and friends take i32 hashes
+        FORCE_INLINE i32 foldHash(u64 h) { return (i32)(u32)(h ^ (h >> 32)); }
+        FORCE_INLINE i32 hash32(const void* data, u64 len) { return foldHash(hash64(data, len)); }
+        FORCE_INLINE i32 hash32(std::string_view str) { return foldHash(hash64(str)); }
+
+        /*
+         * CRC-32C (Castagnoli), e.g. crc32c("123456789") == 0xE3069283.
+         * Streaming: pass previous result as 'crc' to continue, so checksumming chunks
+         * one after another gives the same value as one call over the whole data.
+         * Uses SSE4.2 crc32 with 3 interleaved streams when the cpu has it.
+         */
+        u32 crc32c(const u8* data, u64 size, u32 crc = 0);
+        // table driven (slice-by-8) fallback, always available
+        u32 crc32cSlice8(const u8* data, u64 size, u32 crc = 0);
+
+        /*
+         * Integer mixing policies for hash tables keyed by ints/pointers: mix(u64) -> u64.
+         * Identity is fastest and perfect for dense sequential ids, but strided keys
+         * (multiples of bucket count, aligned pointers, ids with clear low bits) collapse
+         * into few chains. Fmix64/Splitmix scramble all input bits into all output bits.
+         */
+        namespace mix {
+            struct Identity {
+                static constexpr FORCE_INLINE u64 mix(u64 v) { return v; }
+            };
+            // MurmurHash3 fmix64 finalizer
+            struct Fmix64 {
+                static constexpr FORCE_INLINE u64 mix(u64 v) {
+                    v ^= v >> 33;
+                    v *= 0xFF51AFD7ED558CCDull;
+                    v ^= v >> 33;
+                    v *= 0xC4CEB9FE1A85EC53ull;
+                    return v ^ (v >> 33);
+                }
+            };
+            // splitmix64 output function (Stafford variant 13)
+            struct Splitmix {
+                static constexpr FORCE_INLINE u64 mix(u64 v) {
+                    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+                    return v ^ (v >> 31);
+                }
+            };
+        } // namespace mix
+
+        static inline i32 hash(char* c, i32 sz) { return (i32)murmur::MurmurHash3_x86_32(c, sz); }
+
+        struct SHash {
+            static inline i32 hash(const std::string& str) { return hash32(str); }
         };
         struct SHash_STD {
             static inline i32 hash(const std::string& str) {
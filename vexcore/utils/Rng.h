@@ -0,0 +1,442 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+#include <vexcore/containers/Array.h>
+#include <vexcore/utils/CoreTemplates.h>
+
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+/*
+ * Pseudo random engines and Rand front-end over them.
+ * Engine interface: seed(u64), next() -> u32, next64() -> u64, jump(), longJump().
+ * jump() advances the engine by a fixed huge number of steps, so engines made by repeated
+ * jumps from one seed produce non-overlapping sequences (see RandT::makeStreams).
+ */
+namespace vex::simd {
+    // SimdKernels.h, repeated here as it would include HashUtils.h back through SOABuffer.h
+    void randomFill(u32* dst, i32 num, u64 seed);
+    void randomFill01(f32* dst, i32 num, u64 seed);
+} // namespace vex::simd
+
+namespace vex::rng {
+    struct Splitmix64 {
+        static constexpr auto magic = u64(0x9E3779B97F4A7C15);
+        u64 state = 4999559;
+        inline void seed(u64 seed) { state = seed; }
+
+        static constexpr FORCE_INLINE u64 splitmix64_mut(u64& seed) {
+            u64 z = (seed += magic);
+            z = (z ^ (z >> 30)) * u64(0xBF58476D1CE4E5B9);
+            z = (z ^ (z >> 27)) * u64(0x94D049BB133111EB);
+            return z ^ (z >> 31);
+        }
+        static constexpr FORCE_INLINE u64 stateless(u64 in_seed, u64 offset) {
+            in_seed += offset * magic;
+            return splitmix64_mut(in_seed);
+        }
+        FORCE_INLINE u32 next() { return (u32)splitmix64_mut(state); }
+        FORCE_INLINE u64 next64() { return splitmix64_mut(state); }
+
+        // state is a plain counter, so advancing is a single multiply-add
+        // jump: 2^48 steps, longJump: 2^56 steps (period is 2^64)
+        FORCE_INLINE void jump() { state += (u64(1) << 48) * magic; }
+        FORCE_INLINE void longJump() { state += (u64(1) << 56) * magic; }
+    };
+
+    // xoshiro256** (Blackman, Vigna): 2^256-1 period, good all-purpose 64-bit generator
+    struct Xoshiro256ss {
+        u64 s[4] = {0x1C5A1AB1B0FDD0A9, 0x3FD0D3F7A1B2E5C3, 0x0C29AF0E7A52A5D1, 0x7E1D4B8A3C5F6E21};
+
+        inline void seed(u64 seed) {
+            for (u64& v : s)
+                v = Splitmix64::splitmix64_mut(seed);
+        }
+
+        FORCE_INLINE u64 next64() {
+            const u64 result = std::rotl(s[1] * 5, 7) * 9;
+            const u64 t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = std::rotl(s[3], 45);
+            return result;
+        }
+        // upper bits are the better ones
+        FORCE_INLINE u32 next() { return (u32)(next64() >> 32); }
+
+        // 2^128 steps: 2^128 non-overlapping sequences
+        inline void jump() {
+            static constexpr u64 k_jump[] = {
+                0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C};
+            applyJump(k_jump);
+        }
+        // 2^192 steps: 2^64 starting points, each of them can be jump()-ed 2^64 times
+        inline void longJump() {
+            static constexpr u64 k_long_jump[] = {
+                0x76E15D3EFEFDCBBF, 0xC5004E441C522FB3, 0x77710069854EE241, 0x39109BB02ACBE635};
+            applyJump(k_long_jump);
+        }
+
+    private:
+        inline void applyJump(const u64 (&poly)[4]) {
+            u64 acc[4] = {};
+            for (u64 word : poly) {
+                for (u32 b = 0; b < 64; ++b) {
+                    if (word & (u64(1) << b)) {
+                        for (u32 i = 0; i < 4; ++i)
+                            acc[i] ^= s[i];
+                    }
+                    next64();
+                }
+            }
+            for (u32 i = 0; i < 4; ++i)
+                s[i] = acc[i];
+        }
+    };
+
+    // xoshiro128+ (Blackman, Vigna): fastest 32-bit state engine, meant for floats,
+    // lowest bits are weak (linear), so prefer rand01() / upper bits for integers
+    struct Xoshiro128p {
+        u32 s[4] = {0xB0FDD0A9, 0x1C5A1AB1, 0xA1B2E5C3, 0x3FD0D3F7};
+
+        inline void seed(u64 seed) {
+            for (u32 i = 0; i < 4; i += 2) {
+                const u64 v = Splitmix64::splitmix64_mut(seed);
+                s[i] = (u32)v;
+                s[i + 1] = (u32)(v >> 32);
+            }
+        }
+
+        FORCE_INLINE u32 next() {
+            const u32 result = s[0] + s[3];
+            const u32 t = s[1] << 9;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = std::rotl(s[3], 11);
+            return result;
+        }
+        FORCE_INLINE u64 next64() {
+            const u64 hi = next();
+            return (hi << 32) | next();
+        }
+
+        // 2^64 steps: 2^64 non-overlapping sequences
+        inline void jump() {
+            static constexpr u32 k_jump[] = {0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B};
+            applyJump(k_jump);
+        }
+        // 2^96 steps: 2^32 starting points, each of them can be jump()-ed 2^32 times
+        inline void longJump() {
+            static constexpr u32 k_long_jump[] = {0xB523952E, 0x0B6F099F, 0xCCF5A0EF, 0x1C580662};
+            applyJump(k_long_jump);
+        }
+
+    private:
+        inline void applyJump(const u32 (&poly)[4]) {
+            u32 acc[4] = {};
+            for (u32 word : poly) {
+                for (u32 b = 0; b < 32; ++b) {
+                    if (word & (u32(1) << b)) {
+                        for (u32 i = 0; i < 4; ++i)
+                            acc[i] ^= s[i];
+                    }
+                    next();
+                }
+            }
+            for (u32 i = 0; i < 4; ++i)
+                s[i] = acc[i];
+        }
+    };
+
+    // PCG32 (O'Neill), XSH-RR output over 64-bit LCG: period 2^64 per stream
+    struct Pcg32 {
+        static constexpr u64 k_mult = u64(6364136223846793005);
+        static constexpr u64 k_default_stream = u64(1442695040888963407);
+
+        u64 state = u64(0x853C49E6748FEA9B);
+        u64 inc = k_default_stream; // must be odd
+
+        // 'stream' selects one of 2^63 distinct LCG sequences
+        inline void seed(u64 seed, u64 stream) {
+            state = 0;
+            inc = (stream << 1) | 1;
+            next();
+            state += seed;
+            next();
+        }
+        inline void seed(u64 seed) { this->seed(seed, k_default_stream >> 1); }
+
+        FORCE_INLINE u32 next() {
+            const u64 old = state;
+            state = old * k_mult + inc;
+            const u32 xorshifted = (u32)(((old >> 18) ^ old) >> 27);
+            return std::rotr(xorshifted, (i32)(old >> 59));
+        }
+        FORCE_INLINE u64 next64() {
+            const u64 hi = next();
+            return (hi << 32) | next();
+        }
+
+        // LCG can skip ahead in O(log(delta)) (Brown, "Random number generation with
+        // arbitrary strides")
+        inline void advance(u64 delta) {
+            u64 acc_mult = 1;
+            u64 acc_plus = 0;
+            u64 cur_mult = k_mult;
+            u64 cur_plus = inc;
+            while (delta > 0) {
+                if (delta & 1) {
+                    acc_mult *= cur_mult;
+                    acc_plus = acc_plus * cur_mult + cur_plus;
+                }
+                cur_plus = (cur_mult + 1) * cur_plus;
+                cur_mult *= cur_mult;
+                delta >>= 1;
+            }
+            state = acc_mult * state + acc_plus;
+        }
+        // jump: 2^48 steps, longJump: 2^56 steps within the same stream;
+        // seed(seed, stream) with distinct streams is the other way to get independent engines
+        inline void jump() { advance(u64(1) << 48); }
+        inline void longJump() { advance(u64(1) << 56); }
+    };
+
+    /*
+     * Ziggurat tables (Marsaglia, Tsang 2000): 128 layers for normal, 256 for exponential.
+     * k* are acceptance thresholds scaled to 31/32-bit integers, w* convert integer draw to
+     * x within the layer, f* are density values at layer edges.
+     * Built once on first use, the math is too heavy for constexpr.
+     */
+    struct ZigguratTables {
+        static constexpr f64 k_normal_r = 3.442619855899;
+        static constexpr f64 k_normal_v = 9.91256303526217e-3;
+        static constexpr f64 k_exp_r = 7.697117470131487;
+        static constexpr f64 k_exp_v = 3.949659822581572e-3;
+
+        u32 kn[128];
+        f32 wn[128];
+        f32 fn[128];
+        u32 ke[256];
+        f32 we[256];
+        f32 fe[256];
+
+        static inline const ZigguratTables& get() {
+            static const ZigguratTables g_tables = build();
+            return g_tables;
+        }
+
+    private:
+        static ZigguratTables build() {
+            ZigguratTables t;
+            constexpr f64 m1 = 2147483648.0;
+            constexpr f64 m2 = 4294967296.0;
+
+            f64 dn = k_normal_r;
+            f64 tn = dn;
+            const f64 qn = k_normal_v / std::exp(-0.5 * dn * dn);
+            t.kn[0] = (u32)((dn / qn) * m1);
+            t.kn[1] = 0;
+            t.wn[0] = (f32)(qn / m1);
+            t.wn[127] = (f32)(dn / m1);
+            t.fn[0] = 1.0f;
+            t.fn[127] = (f32)std::exp(-0.5 * dn * dn);
+            for (i32 i = 126; i >= 1; --i) {
+                dn = std::sqrt(-2.0 * std::log(k_normal_v / dn + std::exp(-0.5 * dn * dn)));
+                t.kn[i + 1] = (u32)((dn / tn) * m1);
+                tn = dn;
+                t.fn[i] = (f32)std::exp(-0.5 * dn * dn);
+                t.wn[i] = (f32)(dn / m1);
+            }
+
+            f64 de = k_exp_r;
+            f64 te = de;
+            const f64 qe = k_exp_v / std::exp(-de);
+            t.ke[0] = (u32)((de / qe) * m2);
+            t.ke[1] = 0;
+            t.we[0] = (f32)(qe / m2);
+            t.we[255] = (f32)(de / m2);
+            t.fe[0] = 1.0f;
+            t.fe[255] = (f32)std::exp(-de);
+            for (i32 i = 254; i >= 1; --i) {
+                de = -std::log(k_exp_v / de + std::exp(-de));
+                t.ke[i + 1] = (u32)((de / te) * m2);
+                te = de;
+                t.fe[i] = (f32)std::exp(-de);
+                t.we[i] = (f32)(de / m2);
+            }
+            return t;
+        }
+    };
+
+    template <typename TEngine>
+    struct RandT {
+        using Engine = TEngine;
+        static inline Engine g_shared{};
+        Engine engine = Engine{};
+
+        // Init with C rand() (usually a mistake)
+        static inline RandT make() { return make((u64)(::rand())); }
+        // Init with seed
+        static inline RandT make(u64 seed) {
+            RandT result;
+            result.engine.seed(seed);
+            return result;
+        }
+
+        /*
+         * n generators for parallel workers: one seed, every next stream is the previous one
+         * advanced by Engine::jump(), so sequences do not overlap as long as every stream
+         * draws less than the jump distance.
+         */
+        static Buffer<RandT> makeStreams(u64 seed, i32 n, Allocator al = {}) {
+            Buffer<RandT> streams(al, n);
+            RandT cur = make(seed);
+            for (i32 i = 0; i < n; ++i) {
+                streams.add(cur);
+                cur.engine.jump();
+            }
+            return streams;
+        }
+
+        FORCE_INLINE u32 rand() { return engine.next(); }
+        FORCE_INLINE u64 rand64() { return engine.next64(); }
+        FORCE_INLINE float rand01() { return toFloatExpCast(engine.next()); }
+        FORCE_INLINE double randDouble01() { return toDoubleCast(engine.next64()); }
+
+        // unbiased [0, mod), mod > 0. Lemire's multiply-shift: division only on rare retries
+        FORCE_INLINE u32 randMod(u32 mod) {
+            u64 m = (u64)engine.next() * mod;
+            u32 low = (u32)m;
+            [[unlikely]] if (low < mod) {
+                const u32 threshold = (0u - mod) % mod;
+                while (low < threshold) {
+                    m = (u64)engine.next() * mod;
+                    low = (u32)m;
+                }
+            }
+            return (u32)(m >> 32);
+        }
+        // [from_inc, to_exc), to_exc > from_inc, full i32 range is fine
+        FORCE_INLINE i32 randRange(i32 from_inc, i32 to_exc) {
+            return (i32)((u32)from_inc + randMod((u32)to_exc - (u32)from_inc));
+        }
+        FORCE_INLINE f32 randRange(f32 from_inc, f32 to_exc) {
+            return from_inc + rand01() * (to_exc - from_inc);
+        }
+
+        // Ziggurat, ~98.8% (normal) and ~98.9% (exponential) of draws take the fast path:
+        // one 64-bit draw, table lookup, multiply. Layer index and value use disjoint bits.
+        inline f32 randNormal() {
+            const ZigguratTables& t = ZigguratTables::get();
+            for (;;) {
+                const u64 bits = engine.next64();
+                const u32 layer = (u32)bits & 127;
+                const i32 hz = (i32)(bits >> 32);
+                const u32 abs_hz = hz < 0 ? 0u - (u32)hz : (u32)hz;
+                const f32 x = (f32)hz * t.wn[layer];
+                if (abs_hz < t.kn[layer])
+                    return x;
+
+                if (layer == 0) {
+                    // tail beyond r
+                    constexpr f32 r = (f32)ZigguratTables::k_normal_r;
+                    f32 tx, ty;
+                    do {
+                        tx = -std::log(randOpen01()) * (1.0f / r);
+                        ty = -std::log(randOpen01());
+                    } while (ty + ty < tx * tx);
+                    return hz > 0 ? r + tx : -r - tx;
+                }
+                const f32 fy = t.fn[layer] + randOpen01() * (t.fn[layer - 1] - t.fn[layer]);
+                if (fy < std::exp(-0.5f * x * x))
+                    return x;
+            }
+        }
+        FORCE_INLINE f32 randNormal(f32 mean, f32 stddev) { return mean + randNormal() * stddev; }
+
+        // exponential with rate 1 (mean 1)
+        inline f32 randExponential() {
+            const ZigguratTables& t = ZigguratTables::get();
+            for (;;) {
+                const u64 bits = engine.next64();
+                const u32 layer = (u32)bits & 255;
+                const u32 jz = (u32)(bits >> 32);
+                const f32 x = (f32)jz * t.we[layer];
+                if (jz < t.ke[layer])
+                    return x;
+
+                if (layer == 0)
+                    return (f32)ZigguratTables::k_exp_r - std::log(randOpen01());
+                const f32 fy = t.fe[layer] + randOpen01() * (t.fe[layer - 1] - t.fe[layer]);
+                if (fy < std::exp(-x))
+                    return x;
+            }
+        }
+        FORCE_INLINE f32 randExponential(f32 rate) { return randExponential() / rate; }
+
+        // Fisher-Yates, every permutation is equally likely (as long as engine is good)
+        template <typename T>
+        void shuffle(T* items, i32 num) {
+            for (i32 i = num - 1; i > 0; --i) {
+                const i32 j = (i32)randMod((u32)i + 1);
+                std::swap(items[i], items[j]);
+            }
+        }
+        template <typename T>
+        FORCE_INLINE void shuffle(Buffer<T>& items) {
+            shuffle(items.data(), items.size());
+        }
+
+        /*
+         * Batch generation: one engine draw seeds 8 interleaved xoshiro128++ lanes that run
+         * on the widest available SIMD path. Output depends only on engine state, not on the
+         * instruction set. fill01 values are multiples of 2^-24 in [0, 1).
+         */
+        FORCE_INLINE void fill(u32* dst, i32 num) { simd::randomFill(dst, num, engine.next64()); }
+        FORCE_INLINE void fill01(f32* dst, i32 num) {
+            simd::randomFill01(dst, num, engine.next64());
+        }
+        // append 'num' values
+        inline void fill(Buffer<u32>& out, i32 num) {
+            const i32 at = out.size();
+            out.addUninitialized(num);
+            fill(out.data() + at, out.size() - at);
+        }
+        inline void fill01(Buffer<f32>& out, i32 num) {
+            const i32 at = out.size();
+            out.addUninitialized(num);
+            fill01(out.data() + at, out.size() - at);
+        }
+
+    private:
+#pragma warning(push)
+#pragma warning(disable : 4244)
+        static FORCE_INLINE float toFloatExpCast(u32 v) { return v * (1.0f / 4294967296.0f); }
+#pragma warning(pop)
+        // (0, 1), safe for log()
+        FORCE_INLINE f32 randOpen01() {
+            return ((f32)(engine.next() >> 8) + 0.5f) * (1.0f / 16777216.0f);
+        }
+        static constexpr FORCE_INLINE double toDoubleCast(u64 val) {
+            constexpr u64 exp = u64(0x3FF0000000000000);
+            constexpr u64 mantissa = u64(0x000FFFFFFFFFFFFF);
+            u64 random = (val & mantissa) | exp;
+            return std::bit_cast<double>(random) - 1;
+        }
+    };
+
+    using Rand = RandT<Splitmix64>;
+    using RandXoshiro256 = RandT<Xoshiro256ss>;
+    using RandXoshiro128 = RandT<Xoshiro128p>;
+    using RandPcg32 = RandT<Pcg32>;
+} // namespace vex::rng
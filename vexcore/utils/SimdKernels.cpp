@@ -0,0 +1,1012 @@
+#include "SimdKernels.h"
+
+#include <vexcore/utils/Rng.h>
+
+#include <limits.h>
+#include <string.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if VEX_SIMD_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+#if VEX_SIMD_X86 && !defined(_MSC_VER)
+    #define VEX_TARGET_SSE2 __attribute__((target("sse2")))
+    #define VEX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define VEX_TARGET_SSE2
+    #define VEX_TARGET_AVX2
+#endif
+
+namespace vex::simd {
+    static constexpr f32 k_inf = std::numeric_limits<f32>::infinity();
+
+    // hashAccumulate: 16 stripes of 64 bytes per block, stripe s is keyed by
+    // k_hash_secret[s .. s + 8), tail of the secret keys the scramble after each block
+    static constexpr u32 k_hash_stripes = 16;
+    static constexpr u64 k_hash_prime32 = 0x9E3779B1;
+    static constexpr auto k_hash_secret = [] {
+        std::array<u64, k_hash_stripes + 16> secret{};
+        u64 state = 0x243F6A8885A308D3ull;
+        for (u64& v : secret)
+            v = rng::Splitmix64::splitmix64_mut(state);
+        return secret;
+    }();
+    static constexpr const u64* k_hash_scramble = k_hash_secret.data() + k_hash_stripes + 8;
+
+    // ==========================================================================================
+    // cpu detection
+    // ==========================================================================================
+    namespace {
+#if VEX_SIMD_X86
+        void cpuid(u32 leaf, u32 subleaf, u32 out[4]) {
+    #if defined(_MSC_VER)
+            int regs[4];
+            __cpuidex(regs, (int)leaf, (int)subleaf);
+            memcpy(out, regs, sizeof(regs));
+    #else
+            __cpuid_count(leaf, subleaf, out[0], out[1], out[2], out[3]);
+    #endif
+        }
+        u64 xgetbv0() {
+    #if defined(_MSC_VER)
+            return _xgetbv(0);
+    #else
+            u32 lo = 0, hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            return ((u64)hi << 32) | lo;
+    #endif
+        }
+#endif
+
+        CpuFeatures detectFeatures() {
+            CpuFeatures f;
+#if VEX_SIMD_X86
+            u32 regs[4] = {};
+            cpuid(0, 0, regs);
+            const u32 max_leaf = regs[0];
+            if (max_leaf < 1)
+                return f;
+
+            cpuid(1, 0, regs);
+            const u32 ecx1 = regs[2];
+            const u32 edx1 = regs[3];
+            f.sse2 = (edx1 >> 26) & 1;
+            f.sse41 = (ecx1 >> 19) & 1;
+            f.sse42 = (ecx1 >> 20) & 1;
+            f.pclmul = (ecx1 >> 1) & 1;
+
+            const bool osxsave = (ecx1 >> 27) & 1;
+            // OS must save both xmm and ymm state, otherwise AVX is unusable
+            const bool ymm_enabled = osxsave && ((xgetbv0() & 0x6) == 0x6);
+            f.avx = ymm_enabled && ((ecx1 >> 28) & 1);
+            f.fma = f.avx && ((ecx1 >> 12) & 1);
+
+            if (max_leaf >= 7) {
+                cpuid(7, 0, regs);
+                f.avx2 = f.avx && ((regs[1] >> 5) & 1);
+                f.bmi2 = (regs[1] >> 8) & 1;
+            }
+#endif
+            return f;
+        }
+
+        EIsa pickIsa(const CpuFeatures& f) {
+            if (f.avx2 && f.fma)
+                return EIsa::AVX2;
+            if (f.sse2)
+                return EIsa::SSE2;
+            return EIsa::Scalar;
+        }
+    } // namespace
+
+    const CpuFeatures& cpuFeatures() {
+        static const CpuFeatures g_features = detectFeatures();
+        return g_features;
+    }
+
+    EIsa detectedIsa() {
+        static const EIsa g_isa = pickIsa(cpuFeatures());
+        return g_isa;
+    }
+
+    const char* isaName(EIsa isa) {
+        switch (isa) {
+            case EIsa::AVX2:
+                return "avx2";
+            case EIsa::SSE2:
+                return "sse2";
+            default:
+                return "scalar";
+        }
+    }
+
+    // ==========================================================================================
+    // scalar
+    // ==========================================================================================
+    namespace scalar {
+        template <typename T>
+        void fill(T* dst, i32 num, T val) {
+            for (i32 i = 0; i < num; ++i)
+                dst[i] = val;
+        }
+
+        // 8 partial sums, reduced in fixed order (same as vector paths)
+        f32 reduceLanes(const f32 acc[8]) {
+            const f32 lo = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            const f32 hi = (acc[4] + acc[5]) + (acc[6] + acc[7]);
+            return lo + hi;
+        }
+        f32 sum(const f32* src, i32 num) {
+            f32 acc[8] = {};
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                for (i32 l = 0; l < 8; ++l)
+                    acc[l] += src[i + l];
+            }
+            f32 total = reduceLanes(acc);
+            for (; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+        i64 sum(const i32* src, i32 num) {
+            i64 total = 0;
+            for (i32 i = 0; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+
+        template <typename T>
+        T min(const T* src, i32 num, T init) {
+            T r = init;
+            for (i32 i = 0; i < num; ++i)
+                r = src[i] < r ? src[i] : r;
+            return r;
+        }
+        template <typename T>
+        T max(const T* src, i32 num, T init) {
+            T r = init;
+            for (i32 i = 0; i < num; ++i)
+                r = src[i] > r ? src[i] : r;
+            return r;
+        }
+
+        template <typename T>
+        i32 findFirst(const T* src, i32 num, T val) {
+            for (i32 i = 0; i < num; ++i) {
+                if (src[i] == val)
+                    return i;
+            }
+            return -1;
+        }
+        template <typename T>
+        i32 countEqual(const T* src, i32 num, T val) {
+            i32 cnt = 0;
+            for (i32 i = 0; i < num; ++i)
+                cnt += src[i] == val ? 1 : 0;
+            return cnt;
+        }
+
+        void mulAdd(f32* dst, const f32* a, const f32* b, const f32* c, i32 num) {
+            for (i32 i = 0; i < num; ++i)
+                dst[i] = a[i] * b[i] + c[i];
+        }
+        void mulAdd(i32* dst, const i32* a, const i32* b, const i32* c, i32 num) {
+            // wrap around on overflow, do math in unsigned to keep it defined
+            for (i32 i = 0; i < num; ++i)
+                dst[i] = (i32)((u32)a[i] * (u32)b[i] + (u32)c[i]);
+        }
+        void mulAddScalar(f32* dst, const f32* a, f32 scale, i32 num) {
+            for (i32 i = 0; i < num; ++i)
+                dst[i] = a[i] * scale + dst[i];
+        }
+
+        // 8 xoshiro128++ lanes, lane l produces dst[8 * k + l] on every path
+        struct RandLanes {
+            alignas(32) u32 s[4][8];
+        };
+        static constexpr f32 k_unit_f32 = 1.0f / 16777216.0f;
+
+        RandLanes seedRandLanes(u64 seed) {
+            RandLanes st;
+            for (u32 l = 0; l < 8; ++l) {
+                const u64 a = rng::Splitmix64::splitmix64_mut(seed);
+                const u64 b = rng::Splitmix64::splitmix64_mut(seed);
+                st.s[0][l] = (u32)a;
+                st.s[1][l] = (u32)(a >> 32);
+                st.s[2][l] = (u32)b;
+                st.s[3][l] = (u32)(b >> 32);
+            }
+            return st;
+        }
+        FORCE_INLINE void randBlock(RandLanes& st, u32* out) {
+            for (u32 l = 0; l < 8; ++l) {
+                u32& s0 = st.s[0][l];
+                u32& s1 = st.s[1][l];
+                u32& s2 = st.s[2][l];
+                u32& s3 = st.s[3][l];
+                out[l] = std::rotl(s0 + s3, 7) + s0;
+                const u32 t = s1 << 9;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = std::rotl(s3, 11);
+            }
+        }
+        // top 24 bits -> [0, 1), exact in f32 so every path gives the same float
+        FORCE_INLINE f32 toUnitF32(u32 v) { return (f32)(v >> 8) * k_unit_f32; }
+
+        void randomFill(u32* dst, i32 num, u64 seed) {
+            RandLanes st = seedRandLanes(seed);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                randBlock(st, dst + i);
+            if (i < num) {
+                u32 tail[8];
+                randBlock(st, tail);
+                memcpy(dst + i, tail, (num - i) * sizeof(u32));
+            }
+        }
+        void randomFill01(f32* dst, i32 num, u64 seed) {
+            RandLanes st = seedRandLanes(seed);
+            u32 block[8];
+            for (i32 i = 0; i < num; i += 8) {
+                randBlock(st, block);
+                const i32 cnt = num - i < 8 ? num - i : 8;
+                for (i32 l = 0; l < cnt; ++l)
+                    dst[i + l] = toUnitF32(block[l]);
+            }
+        }
+
+        // same math as vector paths: acc[i ^ 1] += d, acc[i] += lo32(d ^ k) * hi32(d ^ k)
+        void hashAccumulate(u64* acc, const u8* data, u64 num_blocks) {
+            for (u64 blk = 0; blk < num_blocks; ++blk) {
+                for (u32 s = 0; s < k_hash_stripes; ++s) {
+                    const u8* in = data + s * 64;
+                    for (u32 i = 0; i < 8; ++i) {
+                        u64 d;
+                        memcpy(&d, in + i * 8, sizeof(d));
+                        const u64 k = d ^ k_hash_secret[s + i];
+                        acc[i ^ 1] += d;
+                        acc[i] += (k & 0xFFFFFFFF) * (k >> 32);
+                    }
+                }
+                for (u32 i = 0; i < 8; ++i) {
+                    u64 a = acc[i];
+                    a ^= a >> 47;
+                    a ^= k_hash_scramble[i];
+                    acc[i] = a * k_hash_prime32;
+                }
+                data += k_hash_stripes * 64;
+            }
+        }
+    } // namespace scalar
+
+#if VEX_SIMD_X86
+    // ==========================================================================================
+    // sse2
+    // ==========================================================================================
+    namespace sse2 {
+        VEX_TARGET_SSE2 void fill(f32* dst, i32 num, f32 val) {
+            const __m128 v = _mm_set1_ps(val);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4)
+                _mm_storeu_ps(dst + i, v);
+            for (; i < num; ++i)
+                dst[i] = val;
+        }
+        VEX_TARGET_SSE2 void fill(i32* dst, i32 num, i32 val) {
+            const __m128i v = _mm_set1_epi32(val);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4)
+                _mm_storeu_si128((__m128i*)(dst + i), v);
+            for (; i < num; ++i)
+                dst[i] = val;
+        }
+
+        VEX_TARGET_SSE2 f32 sum(const f32* src, i32 num) {
+            __m128 lo = _mm_setzero_ps();
+            __m128 hi = _mm_setzero_ps();
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                lo = _mm_add_ps(lo, _mm_loadu_ps(src + i));
+                hi = _mm_add_ps(hi, _mm_loadu_ps(src + i + 4));
+            }
+            alignas(16) f32 acc[8];
+            _mm_store_ps(acc, lo);
+            _mm_store_ps(acc + 4, hi);
+            f32 total = scalar::reduceLanes(acc);
+            for (; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+        VEX_TARGET_SSE2 i64 sum(const i32* src, i32 num) {
+            __m128i acc = _mm_setzero_si128();
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                // sign extend to 64 bit: interleave with sign mask
+                const __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+                acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+                acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+            }
+            alignas(16) i64 lanes[2];
+            _mm_store_si128((__m128i*)lanes, acc);
+            i64 total = lanes[0] + lanes[1];
+            for (; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+
+        VEX_TARGET_SSE2 f32 min(const f32* src, i32 num) {
+            __m128 r = _mm_set1_ps(k_inf);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4)
+                r = _mm_min_ps(r, _mm_loadu_ps(src + i));
+            alignas(16) f32 lanes[4];
+            _mm_store_ps(lanes, r);
+            return scalar::min(src + i, num - i, scalar::min(lanes, 4, lanes[0]));
+        }
+        VEX_TARGET_SSE2 f32 max(const f32* src, i32 num) {
+            __m128 r = _mm_set1_ps(-k_inf);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4)
+                r = _mm_max_ps(r, _mm_loadu_ps(src + i));
+            alignas(16) f32 lanes[4];
+            _mm_store_ps(lanes, r);
+            return scalar::max(src + i, num - i, scalar::max(lanes, 4, lanes[0]));
+        }
+        // no pminsd/pmaxsd in sse2, select through compare mask
+        VEX_TARGET_SSE2 FORCE_INLINE __m128i select(__m128i mask, __m128i a, __m128i b) {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+        VEX_TARGET_SSE2 i32 min(const i32* src, i32 num) {
+            __m128i r = _mm_set1_epi32(INT32_MAX);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                r = select(_mm_cmplt_epi32(v, r), v, r);
+            }
+            alignas(16) i32 lanes[4];
+            _mm_store_si128((__m128i*)lanes, r);
+            return scalar::min(src + i, num - i, scalar::min(lanes, 4, lanes[0]));
+        }
+        VEX_TARGET_SSE2 i32 max(const i32* src, i32 num) {
+            __m128i r = _mm_set1_epi32(INT32_MIN);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+                r = select(_mm_cmpgt_epi32(v, r), v, r);
+            }
+            alignas(16) i32 lanes[4];
+            _mm_store_si128((__m128i*)lanes, r);
+            return scalar::max(src + i, num - i, scalar::max(lanes, 4, lanes[0]));
+        }
+
+        VEX_TARGET_SSE2 i32 findFirst(const f32* src, i32 num, f32 val) {
+            const __m128 v = _mm_set1_ps(val);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(src + i), v));
+                if (mask != 0)
+                    return i + std::countr_zero((u32)mask);
+            }
+            const i32 tail = scalar::findFirst(src + i, num - i, val);
+            return tail >= 0 ? i + tail : -1;
+        }
+        VEX_TARGET_SSE2 i32 findFirst(const i32* src, i32 num, i32 val) {
+            const __m128i v = _mm_set1_epi32(val);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(src + i)), v);
+                const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+                if (mask != 0)
+                    return i + std::countr_zero((u32)mask);
+            }
+            const i32 tail = scalar::findFirst(src + i, num - i, val);
+            return tail >= 0 ? i + tail : -1;
+        }
+        VEX_TARGET_SSE2 i32 countEqual(const f32* src, i32 num, f32 val) {
+            const __m128 v = _mm_set1_ps(val);
+            __m128i acc = _mm_setzero_si128();
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                // mask lanes are -1, so subtracting counts matches
+                const __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(src + i), v);
+                acc = _mm_sub_epi32(acc, _mm_castps_si128(eq));
+            }
+            alignas(16) i32 lanes[4];
+            _mm_store_si128((__m128i*)lanes, acc);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+                   scalar::countEqual(src + i, num - i, val);
+        }
+        VEX_TARGET_SSE2 i32 countEqual(const i32* src, i32 num, i32 val) {
+            const __m128i v = _mm_set1_epi32(val);
+            __m128i acc = _mm_setzero_si128();
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(src + i)), v);
+                acc = _mm_sub_epi32(acc, eq);
+            }
+            alignas(16) i32 lanes[4];
+            _mm_store_si128((__m128i*)lanes, acc);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+                   scalar::countEqual(src + i, num - i, val);
+        }
+
+        VEX_TARGET_SSE2 void mulAdd(f32* dst, const f32* a, const f32* b, const f32* c, i32 num) {
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128 m = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+                _mm_storeu_ps(dst + i, _mm_add_ps(m, _mm_loadu_ps(c + i)));
+            }
+            scalar::mulAdd(dst + i, a + i, b + i, c + i, num - i);
+        }
+        // no pmulld in sse2: multiply even and odd lanes with pmuludq and shuffle back
+        VEX_TARGET_SSE2 FORCE_INLINE __m128i mullo32(__m128i a, __m128i b) {
+            const __m128i even = _mm_mul_epu32(a, b);
+            const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+        VEX_TARGET_SSE2 void mulAdd(i32* dst, const i32* a, const i32* b, const i32* c, i32 num) {
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128i m = mullo32(_mm_loadu_si128((const __m128i*)(a + i)),
+                    _mm_loadu_si128((const __m128i*)(b + i)));
+                const __m128i r = _mm_add_epi32(m, _mm_loadu_si128((const __m128i*)(c + i)));
+                _mm_storeu_si128((__m128i*)(dst + i), r);
+            }
+            scalar::mulAdd(dst + i, a + i, b + i, c + i, num - i);
+        }
+        VEX_TARGET_SSE2 void mulAddScalar(f32* dst, const f32* a, f32 scale, i32 num) {
+            const __m128 s = _mm_set1_ps(scale);
+            i32 i = 0;
+            for (; i + 4 <= num; i += 4) {
+                const __m128 m = _mm_mul_ps(_mm_loadu_ps(a + i), s);
+                _mm_storeu_ps(dst + i, _mm_add_ps(m, _mm_loadu_ps(dst + i)));
+            }
+            scalar::mulAddScalar(dst + i, a + i, scale, num - i);
+        }
+
+        VEX_TARGET_SSE2 FORCE_INLINE __m128i rotl32(__m128i x, i32 k) {
+            return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+        }
+        // lanes 0-3 and 4-7 are two independent xoshiro128++ states
+        struct RandState {
+            __m128i s0[2], s1[2], s2[2], s3[2];
+        };
+        VEX_TARGET_SSE2 FORCE_INLINE RandState loadRand(const scalar::RandLanes& st) {
+            RandState r;
+            for (i32 h = 0; h < 2; ++h) {
+                r.s0[h] = _mm_load_si128((const __m128i*)(st.s[0] + h * 4));
+                r.s1[h] = _mm_load_si128((const __m128i*)(st.s[1] + h * 4));
+                r.s2[h] = _mm_load_si128((const __m128i*)(st.s[2] + h * 4));
+                r.s3[h] = _mm_load_si128((const __m128i*)(st.s[3] + h * 4));
+            }
+            return r;
+        }
+        VEX_TARGET_SSE2 FORCE_INLINE __m128i randStep(RandState& r, i32 h) {
+            const __m128i sum = _mm_add_epi32(r.s0[h], r.s3[h]);
+            const __m128i result = _mm_add_epi32(rotl32(sum, 7), r.s0[h]);
+            const __m128i t = _mm_slli_epi32(r.s1[h], 9);
+            r.s2[h] = _mm_xor_si128(r.s2[h], r.s0[h]);
+            r.s3[h] = _mm_xor_si128(r.s3[h], r.s1[h]);
+            r.s1[h] = _mm_xor_si128(r.s1[h], r.s2[h]);
+            r.s0[h] = _mm_xor_si128(r.s0[h], r.s3[h]);
+            r.s2[h] = _mm_xor_si128(r.s2[h], t);
+            r.s3[h] = rotl32(r.s3[h], 11);
+            return result;
+        }
+        VEX_TARGET_SSE2 FORCE_INLINE __m128 toUnit(__m128i v) {
+            const __m128 f = _mm_cvtepi32_ps(_mm_srli_epi32(v, 8));
+            return _mm_mul_ps(f, _mm_set1_ps(scalar::k_unit_f32));
+        }
+        VEX_TARGET_SSE2 void randomFill(u32* dst, i32 num, u64 seed) {
+            const scalar::RandLanes lanes = scalar::seedRandLanes(seed);
+            RandState r = loadRand(lanes);
+            alignas(16) u32 tail[8];
+            for (i32 i = 0; i < num; i += 8) {
+                u32* out = num - i >= 8 ? dst + i : tail;
+                _mm_storeu_si128((__m128i*)out, randStep(r, 0));
+                _mm_storeu_si128((__m128i*)(out + 4), randStep(r, 1));
+                if (out == tail)
+                    memcpy(dst + i, tail, (num - i) * sizeof(u32));
+            }
+        }
+        VEX_TARGET_SSE2 void randomFill01(f32* dst, i32 num, u64 seed) {
+            const scalar::RandLanes lanes = scalar::seedRandLanes(seed);
+            RandState r = loadRand(lanes);
+            alignas(16) f32 tail[8];
+            for (i32 i = 0; i < num; i += 8) {
+                f32* out = num - i >= 8 ? dst + i : tail;
+                _mm_storeu_ps(out, toUnit(randStep(r, 0)));
+                _mm_storeu_ps(out + 4, toUnit(randStep(r, 1)));
+                if (out == tail)
+                    memcpy(dst + i, tail, (num - i) * sizeof(f32));
+            }
+        }
+
+        VEX_TARGET_SSE2 void hashAccumulate(u64* acc, const u8* data, u64 num_blocks) {
+            __m128i a[4];
+            for (i32 v = 0; v < 4; ++v)
+                a[v] = _mm_loadu_si128((const __m128i*)(acc + v * 2));
+            const __m128i prime = _mm_set1_epi32((i32)k_hash_prime32);
+            for (u64 blk = 0; blk < num_blocks; ++blk) {
+                for (u32 s = 0; s < k_hash_stripes; ++s) {
+                    const u8* in = data + s * 64;
+                    const u64* key = k_hash_secret.data() + s;
+                    for (i32 v = 0; v < 4; ++v) {
+                        const __m128i d = _mm_loadu_si128((const __m128i*)(in + v * 16));
+                        const __m128i k = _mm_loadu_si128((const __m128i*)(key + v * 2));
+                        const __m128i dk = _mm_xor_si128(d, k);
+                        const __m128i prod = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+                        // swap 64-bit halves: d[i] goes to acc[i ^ 1]
+                        const __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+                        a[v] = _mm_add_epi64(a[v], _mm_add_epi64(prod, swapped));
+                    }
+                }
+                for (i32 v = 0; v < 4; ++v) {
+                    const __m128i key = _mm_loadu_si128((const __m128i*)(k_hash_scramble + v * 2));
+                    __m128i x = _mm_xor_si128(a[v], _mm_srli_epi64(a[v], 47));
+                    x = _mm_xor_si128(x, key);
+                    const __m128i lo = _mm_mul_epu32(x, prime);
+                    const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(x, 32), prime);
+                    a[v] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+                }
+                data += k_hash_stripes * 64;
+            }
+            for (i32 v = 0; v < 4; ++v)
+                _mm_storeu_si128((__m128i*)(acc + v * 2), a[v]);
+        }
+    } // namespace sse2
+
+    // ==========================================================================================
+    // avx2
+    // ==========================================================================================
+    namespace avx2 {
+        VEX_TARGET_AVX2 void fill(f32* dst, i32 num, f32 val) {
+            const __m256 v = _mm256_set1_ps(val);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                _mm256_storeu_ps(dst + i, v);
+            for (; i < num; ++i)
+                dst[i] = val;
+        }
+        VEX_TARGET_AVX2 void fill(i32* dst, i32 num, i32 val) {
+            const __m256i v = _mm256_set1_epi32(val);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                _mm256_storeu_si256((__m256i*)(dst + i), v);
+            for (; i < num; ++i)
+                dst[i] = val;
+        }
+
+        VEX_TARGET_AVX2 f32 sum(const f32* src, i32 num) {
+            __m256 acc = _mm256_setzero_ps();
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                acc = _mm256_add_ps(acc, _mm256_loadu_ps(src + i));
+            alignas(32) f32 lanes[8];
+            _mm256_store_ps(lanes, acc);
+            f32 total = scalar::reduceLanes(lanes);
+            for (; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+        VEX_TARGET_AVX2 i64 sum(const i32* src, i32 num) {
+            __m256i acc = _mm256_setzero_si256();
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+            alignas(32) i64 lanes[4];
+            _mm256_store_si256((__m256i*)lanes, acc);
+            i64 total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            for (; i < num; ++i)
+                total += src[i];
+            return total;
+        }
+
+        VEX_TARGET_AVX2 f32 min(const f32* src, i32 num) {
+            __m256 r = _mm256_set1_ps(k_inf);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                r = _mm256_min_ps(r, _mm256_loadu_ps(src + i));
+            alignas(32) f32 lanes[8];
+            _mm256_store_ps(lanes, r);
+            return scalar::min(src + i, num - i, scalar::min(lanes, 8, lanes[0]));
+        }
+        VEX_TARGET_AVX2 f32 max(const f32* src, i32 num) {
+            __m256 r = _mm256_set1_ps(-k_inf);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                r = _mm256_max_ps(r, _mm256_loadu_ps(src + i));
+            alignas(32) f32 lanes[8];
+            _mm256_store_ps(lanes, r);
+            return scalar::max(src + i, num - i, scalar::max(lanes, 8, lanes[0]));
+        }
+        VEX_TARGET_AVX2 i32 min(const i32* src, i32 num) {
+            __m256i r = _mm256_set1_epi32(INT32_MAX);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                r = _mm256_min_epi32(r, _mm256_loadu_si256((const __m256i*)(src + i)));
+            alignas(32) i32 lanes[8];
+            _mm256_store_si256((__m256i*)lanes, r);
+            return scalar::min(src + i, num - i, scalar::min(lanes, 8, lanes[0]));
+        }
+        VEX_TARGET_AVX2 i32 max(const i32* src, i32 num) {
+            __m256i r = _mm256_set1_epi32(INT32_MIN);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                r = _mm256_max_epi32(r, _mm256_loadu_si256((const __m256i*)(src + i)));
+            alignas(32) i32 lanes[8];
+            _mm256_store_si256((__m256i*)lanes, r);
+            return scalar::max(src + i, num - i, scalar::max(lanes, 8, lanes[0]));
+        }
+
+        VEX_TARGET_AVX2 i32 findFirst(const f32* src, i32 num, f32 val) {
+            const __m256 v = _mm256_set1_ps(val);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(src + i), v, _CMP_EQ_OQ);
+                const int mask = _mm256_movemask_ps(eq);
+                if (mask != 0)
+                    return i + std::countr_zero((u32)mask);
+            }
+            const i32 tail = scalar::findFirst(src + i, num - i, val);
+            return tail >= 0 ? i + tail : -1;
+        }
+        VEX_TARGET_AVX2 i32 findFirst(const i32* src, i32 num, i32 val) {
+            const __m256i v = _mm256_set1_epi32(val);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i eq =
+                    _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(src + i)), v);
+                const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+                if (mask != 0)
+                    return i + std::countr_zero((u32)mask);
+            }
+            const i32 tail = scalar::findFirst(src + i, num - i, val);
+            return tail >= 0 ? i + tail : -1;
+        }
+        VEX_TARGET_AVX2 i32 countEqual(const f32* src, i32 num, f32 val) {
+            const __m256 v = _mm256_set1_ps(val);
+            __m256i acc = _mm256_setzero_si256();
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(src + i), v, _CMP_EQ_OQ);
+                acc = _mm256_sub_epi32(acc, _mm256_castps_si256(eq));
+            }
+            alignas(32) i32 lanes[8];
+            _mm256_store_si256((__m256i*)lanes, acc);
+            i32 cnt = 0;
+            for (i32 l = 0; l < 8; ++l)
+                cnt += lanes[l];
+            return cnt + scalar::countEqual(src + i, num - i, val);
+        }
+        VEX_TARGET_AVX2 i32 countEqual(const i32* src, i32 num, i32 val) {
+            const __m256i v = _mm256_set1_epi32(val);
+            __m256i acc = _mm256_setzero_si256();
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i eq =
+                    _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(src + i)), v);
+                acc = _mm256_sub_epi32(acc, eq);
+            }
+            alignas(32) i32 lanes[8];
+            _mm256_store_si256((__m256i*)lanes, acc);
+            i32 cnt = 0;
+            for (i32 l = 0; l < 8; ++l)
+                cnt += lanes[l];
+            return cnt + scalar::countEqual(src + i, num - i, val);
+        }
+
+        VEX_TARGET_AVX2 void mulAdd(f32* dst, const f32* a, const f32* b, const f32* c, i32 num) {
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256 r = _mm256_fmadd_ps(
+                    _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i));
+                _mm256_storeu_ps(dst + i, r);
+            }
+            for (; i < num; ++i)
+                dst[i] = std::fma(a[i], b[i], c[i]);
+        }
+        VEX_TARGET_AVX2 void mulAdd(i32* dst, const i32* a, const i32* b, const i32* c, i32 num) {
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i m = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                    _mm256_loadu_si256((const __m256i*)(b + i)));
+                const __m256i r = _mm256_add_epi32(m, _mm256_loadu_si256((const __m256i*)(c + i)));
+                _mm256_storeu_si256((__m256i*)(dst + i), r);
+            }
+            scalar::mulAdd(dst + i, a + i, b + i, c + i, num - i);
+        }
+        VEX_TARGET_AVX2 void mulAddScalar(f32* dst, const f32* a, f32 scale, i32 num) {
+            const __m256 s = _mm256_set1_ps(scale);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256 r =
+                    _mm256_fmadd_ps(_mm256_loadu_ps(a + i), s, _mm256_loadu_ps(dst + i));
+                _mm256_storeu_ps(dst + i, r);
+            }
+            for (; i < num; ++i)
+                dst[i] = std::fma(a[i], scale, dst[i]);
+        }
+
+        VEX_TARGET_AVX2 FORCE_INLINE __m256i rotl32(__m256i x, i32 k) {
+            return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+        }
+        struct RandState {
+            __m256i s0, s1, s2, s3;
+        };
+        VEX_TARGET_AVX2 FORCE_INLINE RandState loadRand(const scalar::RandLanes& st) {
+            return {_mm256_load_si256((const __m256i*)st.s[0]),
+                _mm256_load_si256((const __m256i*)st.s[1]),
+                _mm256_load_si256((const __m256i*)st.s[2]),
+                _mm256_load_si256((const __m256i*)st.s[3])};
+        }
+        VEX_TARGET_AVX2 FORCE_INLINE __m256i randStep(RandState& r) {
+            const __m256i result = _mm256_add_epi32(rotl32(_mm256_add_epi32(r.s0, r.s3), 7), r.s0);
+            const __m256i t = _mm256_slli_epi32(r.s1, 9);
+            r.s2 = _mm256_xor_si256(r.s2, r.s0);
+            r.s3 = _mm256_xor_si256(r.s3, r.s1);
+            r.s1 = _mm256_xor_si256(r.s1, r.s2);
+            r.s0 = _mm256_xor_si256(r.s0, r.s3);
+            r.s2 = _mm256_xor_si256(r.s2, t);
+            r.s3 = rotl32(r.s3, 11);
+            return result;
+        }
+        VEX_TARGET_AVX2 void randomFill(u32* dst, i32 num, u64 seed) {
+            const scalar::RandLanes lanes = scalar::seedRandLanes(seed);
+            RandState r = loadRand(lanes);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8)
+                _mm256_storeu_si256((__m256i*)(dst + i), randStep(r));
+            if (i < num) {
+                alignas(32) u32 tail[8];
+                _mm256_store_si256((__m256i*)tail, randStep(r));
+                memcpy(dst + i, tail, (num - i) * sizeof(u32));
+            }
+        }
+        VEX_TARGET_AVX2 void randomFill01(f32* dst, i32 num, u64 seed) {
+            const scalar::RandLanes lanes = scalar::seedRandLanes(seed);
+            RandState r = loadRand(lanes);
+            const __m256 unit = _mm256_set1_ps(scalar::k_unit_f32);
+            i32 i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256 f = _mm256_cvtepi32_ps(_mm256_srli_epi32(randStep(r), 8));
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(f, unit));
+            }
+            if (i < num) {
+                alignas(32) f32 tail[8];
+                const __m256 f = _mm256_cvtepi32_ps(_mm256_srli_epi32(randStep(r), 8));
+                _mm256_store_ps(tail, _mm256_mul_ps(f, unit));
+                memcpy(dst + i, tail, (num - i) * sizeof(f32));
+            }
+        }
+
+        VEX_TARGET_AVX2 void hashAccumulate(u64* acc, const u8* data, u64 num_blocks) {
+            __m256i a[2];
+            for (i32 v = 0; v < 2; ++v)
+                a[v] = _mm256_loadu_si256((const __m256i*)(acc + v * 4));
+            const __m256i prime = _mm256_set1_epi32((i32)k_hash_prime32);
+            for (u64 blk = 0; blk < num_blocks; ++blk) {
+                for (u32 s = 0; s < k_hash_stripes; ++s) {
+                    const u8* in = data + s * 64;
+                    const u64* key = k_hash_secret.data() + s;
+                    for (i32 v = 0; v < 2; ++v) {
+                        const __m256i d = _mm256_loadu_si256((const __m256i*)(in + v * 32));
+                        const __m256i k = _mm256_loadu_si256((const __m256i*)(key + v * 4));
+                        const __m256i dk = _mm256_xor_si256(d, k);
+                        const __m256i prod = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+                        const __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+                        a[v] = _mm256_add_epi64(a[v], _mm256_add_epi64(prod, swapped));
+                    }
+                }
+                for (i32 v = 0; v < 2; ++v) {
+                    const __m256i key =
+                        _mm256_loadu_si256((const __m256i*)(k_hash_scramble + v * 4));
+                    __m256i x = _mm256_xor_si256(a[v], _mm256_srli_epi64(a[v], 47));
+                    x = _mm256_xor_si256(x, key);
+                    const __m256i lo = _mm256_mul_epu32(x, prime);
+                    const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), prime);
+                    a[v] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+                }
+                data += k_hash_stripes * 64;
+            }
+            for (i32 v = 0; v < 2; ++v)
+                _mm256_storeu_si256((__m256i*)(acc + v * 4), a[v]);
+        }
+    } // namespace avx2
+#endif // VEX_SIMD_X86
+
+    // ==========================================================================================
+    // dispatch
+    // ==========================================================================================
+    namespace {
+        struct KernelTable {
+            void (*fill_f32)(f32*, i32, f32) = nullptr;
+            void (*fill_i32)(i32*, i32, i32) = nullptr;
+            f32 (*sum_f32)(const f32*, i32) = nullptr;
+            i64 (*sum_i32)(const i32*, i32) = nullptr;
+            f32 (*min_f32)(const f32*, i32) = nullptr;
+            f32 (*max_f32)(const f32*, i32) = nullptr;
+            i32 (*min_i32)(const i32*, i32) = nullptr;
+            i32 (*max_i32)(const i32*, i32) = nullptr;
+            i32 (*find_f32)(const f32*, i32, f32) = nullptr;
+            i32 (*find_i32)(const i32*, i32, i32) = nullptr;
+            i32 (*count_f32)(const f32*, i32, f32) = nullptr;
+            i32 (*count_i32)(const i32*, i32, i32) = nullptr;
+            void (*mul_add_f32)(f32*, const f32*, const f32*, const f32*, i32) = nullptr;
+            void (*mul_add_i32)(i32*, const i32*, const i32*, const i32*, i32) = nullptr;
+            void (*mul_add_scalar_f32)(f32*, const f32*, f32, i32) = nullptr;
+            void (*random_fill)(u32*, i32, u64) = nullptr;
+            void (*random_fill01)(f32*, i32, u64) = nullptr;
+            void (*hash_accumulate)(u64*, const u8*, u64) = nullptr;
+            EIsa isa = EIsa::Scalar;
+        };
+
+        KernelTable makeTable(EIsa isa) {
+            KernelTable t;
+            t.isa = EIsa::Scalar;
+            t.fill_f32 = &scalar::fill<f32>;
+            t.fill_i32 = &scalar::fill<i32>;
+            t.sum_f32 = [](const f32* s, i32 n) { return scalar::sum(s, n); };
+            t.sum_i32 = [](const i32* s, i32 n) { return scalar::sum(s, n); };
+            t.min_f32 = [](const f32* s, i32 n) { return scalar::min(s, n, k_inf); };
+            t.max_f32 = [](const f32* s, i32 n) { return scalar::max(s, n, -k_inf); };
+            t.min_i32 = [](const i32* s, i32 n) { return scalar::min(s, n, (i32)INT32_MAX); };
+            t.max_i32 = [](const i32* s, i32 n) { return scalar::max(s, n, (i32)INT32_MIN); };
+            t.find_f32 = &scalar::findFirst<f32>;
+            t.find_i32 = &scalar::findFirst<i32>;
+            t.count_f32 = &scalar::countEqual<f32>;
+            t.count_i32 = &scalar::countEqual<i32>;
+            t.mul_add_f32 = [](f32* d, const f32* a, const f32* b, const f32* c, i32 n) {
+                scalar::mulAdd(d, a, b, c, n);
+            };
+            t.mul_add_i32 = [](i32* d, const i32* a, const i32* b, const i32* c, i32 n) {
+                scalar::mulAdd(d, a, b, c, n);
+            };
+            t.mul_add_scalar_f32 = &scalar::mulAddScalar;
+            t.random_fill = &scalar::randomFill;
+            t.random_fill01 = &scalar::randomFill01;
+            t.hash_accumulate = &scalar::hashAccumulate;
+#if VEX_SIMD_X86
+            if (isa == EIsa::SSE2) {
+                t.isa = EIsa::SSE2;
+                t.fill_f32 = [](f32* d, i32 n, f32 v) { sse2::fill(d, n, v); };
+                t.fill_i32 = [](i32* d, i32 n, i32 v) { sse2::fill(d, n, v); };
+                t.sum_f32 = [](const f32* s, i32 n) { return sse2::sum(s, n); };
+                t.sum_i32 = [](const i32* s, i32 n) { return sse2::sum(s, n); };
+                t.min_f32 = [](const f32* s, i32 n) { return sse2::min(s, n); };
+                t.max_f32 = [](const f32* s, i32 n) { return sse2::max(s, n); };
+                t.min_i32 = [](const i32* s, i32 n) { return sse2::min(s, n); };
+                t.max_i32 = [](const i32* s, i32 n) { return sse2::max(s, n); };
+                t.find_f32 = [](const f32* s, i32 n, f32 v) { return sse2::findFirst(s, n, v); };
+                t.find_i32 = [](const i32* s, i32 n, i32 v) { return sse2::findFirst(s, n, v); };
+                t.count_f32 = [](const f32* s, i32 n, f32 v) { return sse2::countEqual(s, n, v); };
+                t.count_i32 = [](const i32* s, i32 n, i32 v) { return sse2::countEqual(s, n, v); };
+                t.mul_add_f32 = [](f32* d, const f32* a, const f32* b, const f32* c, i32 n) {
+                    sse2::mulAdd(d, a, b, c, n);
+                };
+                t.mul_add_i32 = [](i32* d, const i32* a, const i32* b, const i32* c, i32 n) {
+                    sse2::mulAdd(d, a, b, c, n);
+                };
+                t.mul_add_scalar_f32 = &sse2::mulAddScalar;
+                t.random_fill = &sse2::randomFill;
+                t.random_fill01 = &sse2::randomFill01;
+                t.hash_accumulate = &sse2::hashAccumulate;
+            } else if (isa == EIsa::AVX2) {
+                t.isa = EIsa::AVX2;
+                t.fill_f32 = [](f32* d, i32 n, f32 v) { avx2::fill(d, n, v); };
+                t.fill_i32 = [](i32* d, i32 n, i32 v) { avx2::fill(d, n, v); };
+                t.sum_f32 = [](const f32* s, i32 n) { return avx2::sum(s, n); };
+                t.sum_i32 = [](const i32* s, i32 n) { return avx2::sum(s, n); };
+                t.min_f32 = [](const f32* s, i32 n) { return avx2::min(s, n); };
+                t.max_f32 = [](const f32* s, i32 n) { return avx2::max(s, n); };
+                t.min_i32 = [](const i32* s, i32 n) { return avx2::min(s, n); };
+                t.max_i32 = [](const i32* s, i32 n) { return avx2::max(s, n); };
+                t.find_f32 = [](const f32* s, i32 n, f32 v) { return avx2::findFirst(s, n, v); };
+                t.find_i32 = [](const i32* s, i32 n, i32 v) { return avx2::findFirst(s, n, v); };
+                t.count_f32 = [](const f32* s, i32 n, f32 v) { return avx2::countEqual(s, n, v); };
+                t.count_i32 = [](const i32* s, i32 n, i32 v) { return avx2::countEqual(s, n, v); };
+                t.mul_add_f32 = [](f32* d, const f32* a, const f32* b, const f32* c, i32 n) {
+                    avx2::mulAdd(d, a, b, c, n);
+                };
+                t.mul_add_i32 = [](i32* d, const i32* a, const i32* b, const i32* c, i32 n) {
+                    avx2::mulAdd(d, a, b, c, n);
+                };
+                t.mul_add_scalar_f32 = &avx2::mulAddScalar;
+                t.random_fill = &avx2::randomFill;
+                t.random_fill01 = &avx2::randomFill01;
+                t.hash_accumulate = &avx2::hashAccumulate;
+            }
+#endif
+            return t;
+        }
+
+        // tables never change after construction, forceIsa only swaps the published pointer
+        const KernelTable& tableFor(EIsa isa) {
+            static const KernelTable g_tables[] = {
+                makeTable(EIsa::Scalar), makeTable(EIsa::SSE2), makeTable(EIsa::AVX2)};
+            return g_tables[(u8)isa];
+        }
+        std::atomic<const KernelTable*>& activeTable() {
+            static std::atomic<const KernelTable*> g_active{&tableFor(detectedIsa())};
+            return g_active;
+        }
+        FORCE_INLINE const KernelTable& table() {
+            return *activeTable().load(std::memory_order_acquire);
+        }
+    } // namespace
+
+    EIsa activeIsa() { return table().isa; }
+
+    void forceIsa(EIsa isa) {
+        if ((u8)isa > (u8)detectedIsa())
+            isa = detectedIsa();
+        activeTable().store(&tableFor(isa), std::memory_order_release);
+    }
+
+    void fill(f32* dst, i32 num, f32 val) { table().fill_f32(dst, num, val); }
+    void fill(i32* dst, i32 num, i32 val) { table().fill_i32(dst, num, val); }
+    // libc memcpy is already vectorized and tuned per cpu, no reason to compete with it
+    void copy(f32* dst, const f32* src, i32 num) {
+        if (num > 0)
+            memmove(dst, src, num * sizeof(f32));
+    }
+    void copy(i32* dst, const i32* src, i32 num) {
+        if (num > 0)
+            memmove(dst, src, num * sizeof(i32));
+    }
+
+    f32 sum(const f32* src, i32 num) { return table().sum_f32(src, num); }
+    i64 sum(const i32* src, i32 num) { return table().sum_i32(src, num); }
+    f32 min(const f32* src, i32 num) { return table().min_f32(src, num); }
+    f32 max(const f32* src, i32 num) { return table().max_f32(src, num); }
+    i32 min(const i32* src, i32 num) { return table().min_i32(src, num); }
+    i32 max(const i32* src, i32 num) { return table().max_i32(src, num); }
+
+    i32 findFirst(const f32* src, i32 num, f32 val) { return table().find_f32(src, num, val); }
+    i32 findFirst(const i32* src, i32 num, i32 val) { return table().find_i32(src, num, val); }
+    i32 countEqual(const f32* src, i32 num, f32 val) { return table().count_f32(src, num, val); }
+    i32 countEqual(const i32* src, i32 num, i32 val) { return table().count_i32(src, num, val); }
+
+    void mulAdd(f32* dst, const f32* a, const f32* b, const f32* c, i32 num) {
+        table().mul_add_f32(dst, a, b, c, num);
+    }
+    void mulAdd(i32* dst, const i32* a, const i32* b, const i32* c, i32 num) {
+        table().mul_add_i32(dst, a, b, c, num);
+    }
+    void mulAddScalar(f32* dst, const f32* a, f32 scale, i32 num) {
+        table().mul_add_scalar_f32(dst, a, scale, num);
+    }
+
+    void randomFill(u32* dst, i32 num, u64 seed) {
+        if (num > 0)
+            table().random_fill(dst, num, seed);
+    }
+    void randomFill01(f32* dst, i32 num, u64 seed) {
+        if (num > 0)
+            table().random_fill01(dst, num, seed);
+    }
+
+    void hashAccumulate(u64* acc, const u8* data, u64 num_blocks) {
+        table().hash_accumulate(acc, data, num_blocks);
+    }
+} // namespace vex::simd
@@ -0,0 +1,118 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/containers/SOABuffer.h>
+#include <vexcore/utils/CoreTemplates.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define VEX_SIMD_X86 1
+#else
+    #define VEX_SIMD_X86 0
+#endif
+
+/*
+ * Column kernels over contiguous f32/i32 ranges.
+ * Implementation is selected once at runtime (CPUID): AVX2 -> SSE2 -> scalar.
+ * Reductions (sum) use the same 8-lane accumulation order on every path, so results do not
+ * depend on selected instruction set. mulAdd on AVX2 path is fused (single rounding).
+ * Min/max do not handle NaNs.
+ */
+namespace vex::simd {
+    enum class EIsa : u8 { Scalar, SSE2, AVX2 };
+
+    struct CpuFeatures {
+        bool sse2 = false;
+        bool sse41 = false;
+        bool sse42 = false;
+        bool pclmul = false;
+        bool avx = false;
+        bool avx2 = false;
+        bool fma = false;
+        bool bmi2 = false;
+    };
+
+    const CpuFeatures& cpuFeatures();
+
+    // best available on this machine
+    EIsa detectedIsa();
+    EIsa activeIsa();
+    // override selection (e.g. to compare paths in benchmarks), clamped to detectedIsa()
+    // safe while other threads run kernels, calls already in flight finish on the old path
+    void forceIsa(EIsa isa);
+    const char* isaName(EIsa isa);
+
+    void fill(f32* dst, i32 num, f32 val);
+    void fill(i32* dst, i32 num, i32 val);
+    void copy(f32* dst, const f32* src, i32 num);
+    void copy(i32* dst, const i32* src, i32 num);
+
+    f32 sum(const f32* src, i32 num);
+    i64 sum(const i32* src, i32 num);
+    // min/max of empty range are +inf/-inf (INT32_MAX/INT32_MIN for i32)
+    f32 min(const f32* src, i32 num);
+    f32 max(const f32* src, i32 num);
+    i32 min(const i32* src, i32 num);
+    i32 max(const i32* src, i32 num);
+
+    // index of the first element equal to val or -1
+    i32 findFirst(const f32* src, i32 num, f32 val);
+    i32 findFirst(const i32* src, i32 num, i32 val);
+    i32 countEqual(const f32* src, i32 num, f32 val);
+    i32 countEqual(const i32* src, i32 num, i32 val);
+
+    // dst[i] = a[i] * b[i] + c[i], dst may alias any of inputs
+    void mulAdd(f32* dst, const f32* a, const f32* b, const f32* c, i32 num);
+    void mulAdd(i32* dst, const i32* a, const i32* b, const i32* c, i32 num);
+    // dst[i] = a[i] * scale + dst[i]
+    void mulAddScalar(f32* dst, const f32* a, f32 scale, i32 num);
+
+    // 8 interleaved xoshiro128++ lanes seeded from 'seed', dst[8 * k + l] is k-th output of
+    // lane l, so sequence is the same on every path. fill01 maps top 24 bits to [0, 1).
+    // rng::RandT::fill/fill01 is the usual entry point.
+    void randomFill(u32* dst, i32 num, u64 seed);
+    void randomFill01(f32* dst, i32 num, u64 seed);
+
+    // long input reduction for util::hash64: num_blocks * 1024 bytes into 8 accumulators,
+    // integer only, so every path gives the same result
+    void hashAccumulate(u64* acc, const u8* data, u64 num_blocks);
+
+    // span overloads
+    template <typename T>
+    FORCE_INLINE void fill(const RawBuffer<T>& dst, T val) {
+        fill(dst.first, dst.size(), val);
+    }
+    template <typename T>
+    FORCE_INLINE void copy(const RawBuffer<T>& dst, ROSpan<T> src) {
+        copy(dst.first, src.data, dst.size() < src.size() ? dst.size() : src.size());
+    }
+    template <typename T>
+    FORCE_INLINE auto sum(ROSpan<T> src) {
+        return sum(src.data, src.size());
+    }
+    template <typename T>
+    FORCE_INLINE T min(ROSpan<T> src) {
+        return min(src.data, src.size());
+    }
+    template <typename T>
+    FORCE_INLINE T max(ROSpan<T> src) {
+        return max(src.data, src.size());
+    }
+    template <typename T>
+    FORCE_INLINE i32 findFirst(ROSpan<T> src, T val) {
+        return findFirst(src.data, src.size(), val);
+    }
+    template <typename T>
+    FORCE_INLINE i32 countEqual(ROSpan<T> src, T val) {
+        return countEqual(src.data, src.size(), val);
+    }
+    template <typename T>
+    FORCE_INLINE void mulAdd(const RawBuffer<T>& dst, ROSpan<T> a, ROSpan<T> b, ROSpan<T> c) {
+        checkLethal(a.size() >= dst.size() && b.size() >= dst.size() && c.size() >= dst.size(),
+            "input spans are shorter than output");
+        mulAdd(dst.first, a.data, b.data, c.data, dst.size());
+    }
+} // namespace vex::simd
@@ -0,0 +1,362 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/jobs/JobSystem.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/VUtilsBase.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <type_traits>
+
+/*
+ * Sorting of Buffer<T>.
+ *  - integers, floats and KeyIndex pairs: stable LSD radix sort (8 bit digits, passes where
+ *    every element has the same digit are skipped), one scratch allocation per call;
+ *  - anything else with a comparator: std::sort, parallel version sorts chunks and merges them;
+ *  - inputs up to k_network_max are sorted by a branchless compare-exchange network.
+ * Overloads taking JobSystem use it for inputs above k_parallel_min, they must be called from
+ * a worker thread.
+ * Floats are ordered by value with -0.0 < +0.0, NaNs go to the ends depending on their sign.
+ */
+namespace vex {
+    // sorted by key only, stable, so equal keys keep their index order
+    template <typename TKey>
+    struct KeyIndex {
+        TKey key;
+        u32 index;
+    };
+
+    namespace sort_impl {
+        static constexpr i32 k_network_max = 16;
+        static constexpr i32 k_insertion_max = 64;
+        static constexpr i32 k_parallel_min = 64 * 1024;
+        static constexpr i32 k_radix = 256;
+
+        template <typename T>
+        struct RadixTraits;
+
+        template <typename T>
+            requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        struct RadixTraits<T> {
+            using Key = std::make_unsigned_t<T>;
+            static FORCE_INLINE Key key(T v) {
+                if constexpr (std::is_signed_v<T>)
+                    return (Key)v ^ ((Key)1 << (sizeof(T) * 8 - 1));
+                else
+                    return (Key)v;
+            }
+        };
+        template <>
+        struct RadixTraits<f32> {
+            using Key = u32;
+            static FORCE_INLINE Key key(f32 v) {
+                const u32 bits = std::bit_cast<u32>(v);
+                // negative: flip all bits, positive: flip sign bit
+                const u32 mask = (u32)(-(i32)(bits >> 31)) | 0x80000000u;
+                return bits ^ mask;
+            }
+        };
+        template <>
+        struct RadixTraits<f64> {
+            using Key = u64;
+            static FORCE_INLINE Key key(f64 v) {
+                const u64 bits = std::bit_cast<u64>(v);
+                const u64 mask = (u64)(-(i64)(bits >> 63)) | 0x8000000000000000ull;
+                return bits ^ mask;
+            }
+        };
+        template <typename TKey>
+        struct RadixTraits<KeyIndex<TKey>> {
+            using Key = typename RadixTraits<TKey>::Key;
+            static FORCE_INLINE Key key(const KeyIndex<TKey>& v) {
+                return RadixTraits<TKey>::key(v.key);
+            }
+        };
+
+        template <typename T>
+        concept RadixSortable = requires(const T& v) { RadixTraits<T>::key(v); };
+
+        template <typename T>
+        FORCE_INLINE auto radixKey(const T& v) {
+            return RadixTraits<T>::key(v);
+        }
+
+        // ------------------------------------------------------------------------- small
+        /*
+         * Odd-even transposition network: n rounds of independent compare-exchanges of
+         * adjacent elements. No data dependent branches (selects compile to cmov/min/max) and
+         * adjacent swaps only happen on strict inequality, so it is stable.
+         */
+        template <typename T, typename TLess>
+        FORCE_INLINE void compareExchange(T& a, T& b, TLess& less) {
+            const bool swap = less(b, a);
+            const T lo = swap ? b : a;
+            const T hi = swap ? a : b;
+            a = lo;
+            b = hi;
+        }
+        template <typename T, typename TLess>
+        void networkSort(T* data, i32 num, TLess less) {
+            for (i32 round = 0; round < num; ++round) {
+                for (i32 i = round & 1; i + 1 < num; i += 2)
+                    compareExchange(data[i], data[i + 1], less);
+            }
+        }
+        template <typename T, typename TLess>
+        void insertionSort(T* data, i32 num, TLess less) {
+            for (i32 i = 1; i < num; ++i) {
+                const T val = data[i];
+                i32 j = i;
+                for (; j > 0 && less(val, data[j - 1]); --j)
+                    data[j] = data[j - 1];
+                data[j] = val;
+            }
+        }
+        // true if handled
+        template <typename T, typename TLess>
+        bool smallSort(T* data, i32 num, TLess less) {
+            if (num <= k_network_max) {
+                networkSort(data, num, less);
+                return true;
+            }
+            if (num <= k_insertion_max) {
+                insertionSort(data, num, less);
+                return true;
+            }
+            return false;
+        }
+
+        template <typename T>
+        struct RadixLess {
+            FORCE_INLINE bool operator()(const T& a, const T& b) const {
+                return radixKey(a) < radixKey(b);
+            }
+        };
+
+        // ------------------------------------------------------------------------- radix
+        template <typename T>
+        using RadixKeyType = typename RadixTraits<T>::Key;
+        template <typename T>
+        static constexpr i32 k_passes = (i32)sizeof(RadixKeyType<T>);
+
+        template <typename T>
+        FORCE_INLINE u32 digit(const T& v, i32 pass) {
+            return (u32)(radixKey(v) >> (pass * 8)) & (k_radix - 1);
+        }
+
+        // counts of every digit for every pass in one read
+        template <typename T>
+        void histogramAll(const T* src, i32 num, u32* hist) {
+            for (i32 i = 0; i < num; ++i) {
+                const auto key = radixKey(src[i]);
+                for (i32 p = 0; p < k_passes<T>; ++p)
+                    hist[p * k_radix + ((key >> (p * 8)) & (k_radix - 1))]++;
+            }
+        }
+        template <typename T>
+        FORCE_INLINE bool isTrivialPass(const u32* pass_hist, i32 num) {
+            // every element has the same digit -> pass would not move anything
+            for (i32 d = 0; d < k_radix; ++d)
+                if (pass_hist[d] != 0)
+                    return pass_hist[d] == (u32)num;
+            return true;
+        }
+
+        template <typename T>
+        void radixSort(T* data, i32 num, Allocator al) {
+            constexpr i32 passes = k_passes<T>;
+            constexpr u64 hist_bytes = sizeof(u32) * k_radix * passes;
+            // single scratch allocation: ping-pong buffer + histograms
+            const u64 data_bytes = ((u64)num * sizeof(T) + 3) & ~(u64)3;
+            u8* scratch = vexAlloc(al, data_bytes + hist_bytes, alignof(T) > 4 ? alignof(T) : 4);
+            checkLethal(scratch, "failure of allocator");
+            u32* hist = (u32*)(scratch + data_bytes);
+            T* tmp = (T*)scratch;
+            memset(hist, 0, hist_bytes);
+            histogramAll(data, num, hist);
+
+            T* src = data;
+            T* dst = tmp;
+            for (i32 p = 0; p < passes; ++p) {
+                u32* h = hist + p * k_radix;
+                if (isTrivialPass<T>(h, num))
+                    continue;
+                u32 sum = 0;
+                for (i32 d = 0; d < k_radix; ++d) {
+                    const u32 c = h[d];
+                    h[d] = sum;
+                    sum += c;
+                }
+                for (i32 i = 0; i < num; ++i)
+                    dst[h[digit(src[i], p)]++] = src[i];
+                std::swap(src, dst);
+            }
+            if (src != data)
+                memcpy(data, src, num * sizeof(T));
+            vexFree(al, scratch);
+        }
+
+        template <typename T>
+        void radixSortParallel(T* data, i32 num, JobSystem& jobs, Allocator al) {
+            constexpr i32 passes = k_passes<T>;
+            const i32 chunks = jobs.workerCount() * 4;
+            const i32 chunk_len = (num + chunks - 1) / chunks;
+
+            // one allocation: ping-pong buffer + per-chunk digit counts + global histograms
+            const u64 data_bytes = ((u64)num * sizeof(T) + 63) & ~(u64)63;
+            const u64 counts_bytes = sizeof(u32) * k_radix * chunks;
+            const u64 hist_bytes = sizeof(u32) * k_radix * passes;
+            u8* scratch = vexAlloc(al, data_bytes + counts_bytes + hist_bytes, 64);
+            checkLethal(scratch, "failure of allocator");
+            T* tmp = (T*)scratch;
+            u32* counts = (u32*)(scratch + data_bytes); // [chunk][digit]
+            u32* hist = counts + k_radix * chunks;      // [pass][digit]
+
+            // global histograms only decide which passes can be skipped
+            memset(hist, 0, hist_bytes);
+            jobs.parallelFor(Range(0, chunks), 1, [&](Range r) {
+                u32 local[k_radix * passes] = {};
+                for (i32 c = r.range_start; c < r.range_end; ++c) {
+                    const i32 start = c * chunk_len;
+                    const i32 end = start + chunk_len < num ? start + chunk_len : num;
+                    if (start < end)
+                        histogramAll(data + start, end - start, local);
+                }
+                for (i32 i = 0; i < k_radix * passes; ++i) {
+                    if (local[i])
+                        std::atomic_ref<u32>(hist[i]).fetch_add(local[i]);
+                }
+            });
+
+            T* src = data;
+            T* dst = tmp;
+            for (i32 p = 0; p < passes; ++p) {
+                if (isTrivialPass<T>(hist + p * k_radix, num))
+                    continue;
+
+                jobs.parallelFor(Range(0, chunks), 1, [&](Range r) {
+                    for (i32 c = r.range_start; c < r.range_end; ++c) {
+                        u32* cnt = counts + c * k_radix;
+                        memset(cnt, 0, sizeof(u32) * k_radix);
+                        const i32 start = c * chunk_len;
+                        const i32 end = start + chunk_len < num ? start + chunk_len : num;
+                        for (i32 i = start; i < end; ++i)
+                            cnt[digit(src[i], p)]++;
+                    }
+                });
+                // digit-major, chunk-minor prefix keeps the sort stable
+                u32 sum = 0;
+                for (i32 d = 0; d < k_radix; ++d) {
+                    for (i32 c = 0; c < chunks; ++c) {
+                        const u32 v = counts[c * k_radix + d];
+                        counts[c * k_radix + d] = sum;
+                        sum += v;
+                    }
+                }
+                jobs.parallelFor(Range(0, chunks), 1, [&](Range r) {
+                    for (i32 c = r.range_start; c < r.range_end; ++c) {
+                        u32* offs = counts + c * k_radix;
+                        const i32 start = c * chunk_len;
+                        const i32 end = start + chunk_len < num ? start + chunk_len : num;
+                        for (i32 i = start; i < end; ++i)
+                            dst[offs[digit(src[i], p)]++] = src[i];
+                    }
+                });
+                std::swap(src, dst);
+            }
+            if (src != data) {
+                jobs.parallelFor(Range(0, num), 64 * 1024, [&](Range r) {
+                    memcpy(data + r.range_start, src + r.range_start,
+                        (r.range_end - r.range_start) * sizeof(T));
+                });
+            }
+            vexFree(al, scratch);
+        }
+
+        // ------------------------------------------------------------------------- merge
+        template <typename T, typename TLess>
+        void mergeSortParallel(T* data, i32 num, TLess& less, JobSystem& jobs, Allocator al) {
+            T* tmp = vexAllocTyped<T>(al, num);
+            checkLethal(tmp, "failure of allocator");
+
+            i32 run = (num + jobs.workerCount() * 4 - 1) / (jobs.workerCount() * 4);
+            run = run > k_insertion_max ? run : k_insertion_max;
+            jobs.parallelFor(Range(0, (num + run - 1) / run), 1, [&](Range r) {
+                for (i32 c = r.range_start; c < r.range_end; ++c) {
+                    T* first = data + (i64)c * run;
+                    T* last = data + ((i64)(c + 1) * run < num ? (i64)(c + 1) * run : num);
+                    std::stable_sort(first, last, less);
+                }
+            });
+
+            // pairwise merges of sorted runs, ping-pong between data and tmp
+            T* src = data;
+            T* dst = tmp;
+            for (; run < num; run *= 2) {
+                const i32 pairs = (i32)(((i64)num + 2 * (i64)run - 1) / (2 * (i64)run));
+                jobs.parallelFor(Range(0, pairs), 1, [&](Range r) {
+                    for (i32 pr = r.range_start; pr < r.range_end; ++pr) {
+                        const i64 lo = (i64)pr * 2 * run;
+                        const i64 mid = lo + run < num ? lo + run : num;
+                        const i64 hi = lo + 2 * (i64)run < num ? lo + 2 * (i64)run : num;
+                        std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);
+                    }
+                });
+                std::swap(src, dst);
+            }
+            if (src != data)
+                memcpy(data, src, num * sizeof(T));
+            vexFree(al, tmp);
+        }
+    } // namespace sort_impl
+
+    // ----------------------------------------------------------------------------- public
+    template <typename T>
+        requires sort_impl::RadixSortable<T>
+    void sort(Buffer<T>& buf, Allocator scratch = {}) {
+        T* data = buf.data();
+        const i32 num = buf.size();
+        if (sort_impl::smallSort(data, num, sort_impl::RadixLess<T>{}))
+            return;
+        sort_impl::radixSort(data, num, scratch);
+    }
+
+    template <typename T>
+        requires sort_impl::RadixSortable<T>
+    void sort(Buffer<T>& buf, JobSystem& jobs, Allocator scratch = {}) {
+        const i32 num = buf.size();
+        if (num < sort_impl::k_parallel_min || jobs.workerCount() == 1)
+            return sort(buf, scratch);
+        sort_impl::radixSortParallel(buf.data(), num, jobs, scratch);
+    }
+
+    // general path (std::sort), not stable
+    template <typename T, typename TLess>
+    void sort(Buffer<T>& buf, TLess less) {
+        T* data = buf.data();
+        const i32 num = buf.size();
+        if (sort_impl::smallSort(data, num, less))
+            return;
+        std::sort(data, data + num, less);
+    }
+
+    // stable: chunks are sorted with std::stable_sort and merged
+    template <typename T, typename TLess>
+    void sort(Buffer<T>& buf, TLess less, JobSystem& jobs, Allocator scratch = {}) {
+        const i32 num = buf.size();
+        if (num < sort_impl::k_parallel_min || jobs.workerCount() == 1) {
+            T* data = buf.data();
+            if (!sort_impl::smallSort(data, num, less))
+                std::stable_sort(data, data + num, less);
+            return;
+        }
+        sort_impl::mergeSortParallel(buf.data(), num, less, jobs, scratch);
+    }
+} // namespace vex
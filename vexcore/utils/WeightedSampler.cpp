@@ -0,0 +1,104 @@
+#include "WeightedSampler.h"
+
+namespace vex {
+    namespace {
+        FORCE_INLINE u32 toThreshold(f64 prob) {
+            return prob >= 1.0 ? UINT32_MAX : (u32)(prob * 4294967296.0);
+        }
+        FORCE_INLINE void resetTo(Buffer<f64>& buf, i32 num) {
+            buf.setSizeInit(0);
+            buf.addUninitialized(num);
+        }
+    } // namespace
+
+    template <typename T>
+    void WeightedSampler::buildFrom(const T* in_weights, i32 num) {
+        resetTo(weights, num);
+        for (i32 i = 0; i < num; ++i)
+            weights[i] = in_weights[i] > 0 ? (f64)in_weights[i] : 0.0;
+
+        const i32 num_blocks = (num + k_block_size - 1) / k_block_size;
+        resetTo(block_weights, num_blocks);
+        buckets.setSizeInit(0);
+        buckets.addUninitialized(num);
+        blocks.setSizeInit(0);
+        blocks.addUninitialized(num_blocks);
+
+        const i32 scratch_size = num_blocks > k_block_size ? num_blocks : k_block_size;
+        scratch_idx.setSizeInit(0);
+        scratch_idx.addUninitialized(scratch_size);
+        resetTo(scratch_prob, scratch_size);
+
+        for (i32 b = 0; b < num_blocks; ++b)
+            rebuildBlock(b);
+        rebuildTop();
+    }
+
+    void WeightedSampler::build(const f32* in_weights, i32 num) { buildFrom(in_weights, num); }
+    void WeightedSampler::build(const f64* in_weights, i32 num) { buildFrom(in_weights, num); }
+
+    void WeightedSampler::setWeight(i32 i, f64 weight) {
+        checkLethal((i >= 0) && (i < size()), "out of bounds");
+        weights[i] = weight > 0.0 ? weight : 0.0;
+        rebuildBlock(i / k_block_size);
+        rebuildTop();
+    }
+
+    void WeightedSampler::rebuildBlock(i32 block) {
+        const i32 start = block * k_block_size;
+        const i32 len = blockLen(block);
+        f64 sum = 0.0;
+        for (i32 i = 0; i < len; ++i)
+            sum += weights[start + i];
+        block_weights[block] = sum;
+        buildAlias(weights.data() + start, len, sum, buckets.data() + start);
+    }
+
+    void WeightedSampler::rebuildTop() {
+        // summed from block sums, so it does not drift with repeated setWeight()
+        f64 sum = 0.0;
+        for (f64 w : block_weights)
+            sum += w;
+        total_weight = sum;
+        buildAlias(block_weights.data(), block_weights.size(), sum, blocks.data());
+    }
+
+    void WeightedSampler::buildAlias(const f64* in_weights, i32 num, f64 sum, Bucket* out) {
+        if (sum <= 0.0) {
+            for (i32 i = 0; i < num; ++i)
+                out[i] = {UINT32_MAX, i};
+            return;
+        }
+
+        // small indices grow from the front of scratch, large ones from the back
+        f64* prob = scratch_prob.data();
+        i32* idx = scratch_idx.data();
+        i32 num_small = 0;
+        i32 large_begin = num;
+        const f64 scale = (f64)num / sum;
+        for (i32 i = 0; i < num; ++i) {
+            prob[i] = in_weights[i] * scale;
+            if (prob[i] < 1.0)
+                idx[num_small++] = i;
+            else
+                idx[--large_begin] = i;
+        }
+
+        while (num_small > 0 && large_begin < num) {
+            const i32 small = idx[--num_small];
+            const i32 large = idx[large_begin];
+            out[small] = {toThreshold(prob[small]), large};
+            prob[large] = (prob[large] + prob[small]) - 1.0;
+            if (prob[large] < 1.0) {
+                // large becomes small: its slot in the large part is reused
+                large_begin++;
+                idx[num_small++] = large;
+            }
+        }
+        // leftovers are 1.0 up to rounding error
+        for (i32 i = large_begin; i < num; ++i)
+            out[idx[i]] = {UINT32_MAX, idx[i]};
+        for (i32 i = 0; i < num_small; ++i)
+            out[idx[i]] = {UINT32_MAX, idx[i]};
+    }
+} // namespace vex
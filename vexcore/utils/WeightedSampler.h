@@ -0,0 +1,101 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019 Vladyslav Joss
+ */
+
+#include <vexcore/containers/Array.h>
+#include <vexcore/memory/Memory.h>
+#include <vexcore/utils/CoreTemplates.h>
+#include <vexcore/utils/Rng.h>
+
+namespace vex {
+    /*
+     * O(1) sampling of index i with probability weight[i] / totalWeight().
+     * Walker/Vose alias tables in two levels: outcomes are split into blocks of k_block_size,
+     * every block has its own alias table and the top table picks a block by its weight sum.
+     * So setWeight() rebuilds one block and the top table (O(k_block_size + num / k_block_size))
+     * instead of everything.
+     *
+     * sample() takes single rand64(): upper half picks the block, lower half picks the
+     * outcome inside of it. Index and threshold come from one 32-bit multiply, which biases
+     * probabilities by at most n / 2^32 per level.
+     * Result is undefined when all weights are zero.
+     */
+    class WeightedSampler {
+    public:
+        static constexpr i32 k_block_size = 64;
+
+        // alias table slot: take own index if fraction < threshold, otherwise take alias
+        struct Bucket {
+            u32 threshold = 0;
+            i32 alias = 0;
+        };
+
+        WeightedSampler() = default;
+        explicit WeightedSampler(Allocator al)
+        : weights(al), block_weights(al), buckets(al), blocks(al), scratch_idx(al),
+          scratch_prob(al) {}
+
+        // negative weights are treated as zero
+        void build(const f32* in_weights, i32 num);
+        void build(const f64* in_weights, i32 num);
+        FORCE_INLINE void build(ROSpan<f32> in_weights) {
+            build(in_weights.data, in_weights.size());
+        }
+        FORCE_INLINE void build(ROSpan<f64> in_weights) {
+            build(in_weights.data, in_weights.size());
+        }
+
+        // partial rebuild: block of 'i' and top table
+        void setWeight(i32 i, f64 weight);
+
+        FORCE_INLINE auto size() const -> i32 { return weights.size(); }
+        FORCE_INLINE auto weight(i32 i) const -> f64 { return weights[i]; }
+        FORCE_INLINE auto totalWeight() const -> f64 { return total_weight; }
+        FORCE_INLINE auto probability(i32 i) const -> f64 {
+            return total_weight > 0.0 ? weights[i] / total_weight : 0.0;
+        }
+
+        template <typename TRand>
+        FORCE_INLINE i32 sample(TRand& rng) const {
+            checkAlwaysParanoid(size() > 0, "sampling from empty sampler");
+            const u64 bits = rng.rand64();
+            const i32 block = pick(blocks.data(), blocks.size(), (u32)(bits >> 32));
+            const i32 block_start = block * k_block_size;
+            const i32 block_len = blockLen(block);
+            return block_start + pick(buckets.data() + block_start, block_len, (u32)bits);
+        }
+        template <typename TRand>
+        void sampleN(TRand& rng, i32* out, i32 num) const {
+            for (i32 i = 0; i < num; ++i)
+                out[i] = sample(rng);
+        }
+
+    private:
+        static FORCE_INLINE i32 pick(const Bucket* table, i32 num, u32 rnd) {
+            const u64 m = (u64)rnd * (u32)num;
+            const i32 i = (i32)(m >> 32);
+            return (u32)m < table[i].threshold ? i : table[i].alias;
+        }
+        FORCE_INLINE i32 blockLen(i32 block) const {
+            const i32 rest = weights.size() - block * k_block_size;
+            return rest < k_block_size ? rest : k_block_size;
+        }
+
+        template <typename T>
+        void buildFrom(const T* in_weights, i32 num);
+        void rebuildBlock(i32 block);
+        void rebuildTop();
+        // Vose: O(num), scratch has to fit num elements
+        void buildAlias(const f64* in_weights, i32 num, f64 sum, Bucket* out);
+
+        Buffer<f64> weights;
+        Buffer<f64> block_weights;
+        Buffer<Bucket> buckets; // one per outcome, grouped by blocks
+        Buffer<Bucket> blocks;  // top level, one per block
+        Buffer<i32> scratch_idx;
+        Buffer<f64> scratch_prob;
+        f64 total_weight = 0.0;
+    };
+} // namespace vex